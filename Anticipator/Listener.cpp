@@ -1,9 +1,11 @@
 // System definition files.
 //
 #include <unistd.h>
+#include <algorithm>
 #include <cstdbool>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -20,20 +22,60 @@
 
 Anticipator::Listener::Listener(
     const IP::Family        family,
-    const unsigned short    portNumber) :
-Inherited(family, "", portNumber)
+    const unsigned short    portNumber,
+    const unsigned int      numberOfAcceptors) :
+Inherited(family, portNumber)
 {
-    this->thread = std::thread(&Anticipator::Listener::ThreadHandler, this);
+    for (unsigned int acceptorIndex = 0;
+         acceptorIndex < std::max(numberOfAcceptors, 1u);
+         acceptorIndex++)
+    {
+        this->threads.emplace_back(&Anticipator::Listener::ThreadHandler, this);
+    }
+}
+
+/**
+ * @brief   Accept next session on the listening socket.
+ *
+ * @param   generation      Generation of socket the caller has been using.
+ *
+ * @return  Accepted session, or null if socket has been set up again
+ *          in the meantime and caller has to pick up its new generation.
+ */
+Anticipator::Session*
+Anticipator::Listener::acceptSession(const unsigned long generation)
+{
+    if (this->enterSocket(generation) == false)
+        return nullptr;
+
+    Anticipator::Session* session;
+
+    try
+    {
+        session = new Anticipator::Session { *this };
+    }
+    catch (...)
+    {
+        this->leaveSocket();
+
+        throw;
+    }
+
+    this->leaveSocket();
+
+    return session;
 }
 
 /**
- * @brief   Thread handler for service.
+ * @brief   Thread handler for acceptor.
  */
 void
 Anticipator::Listener::ThreadHandler(Anticipator::Listener* listener)
 {
     ReportNotice("[Anticipator] Service thread has been started");
 
+    unsigned long generation = 0;
+
     // Endless loop. In case an error on socket layer occurs,
     // the socket recovery will start automatically
     // at the beginning of the loop.
@@ -42,12 +84,16 @@ Anticipator::Listener::ThreadHandler(Anticipator::Listener* listener)
     {
         try
         {
-            listener->disconnect();
-            listener->connect();
+            generation = listener->recover(generation);
 
             for (;;)
             {
-                Anticipator::Session* session = new Anticipator::Session { *listener };
+                Anticipator::Session* session = listener->acceptSession(generation);
+
+                // Socket has been set up again by another acceptor.
+                //
+                if (session == nullptr)
+                    break;
 
                 std::thread sessionThread
                 {
@@ -3,33 +3,37 @@
 // System definition files.
 //
 #include <thread>
-
-// Common definition files.
-//
-#include "Communicator/TCP.hpp"
+#include <vector>
 
 // Local definition files.
 //
+#include "Primus/SharedListener.hpp"
 #include "Primus/Database/Phoenix.hpp"
 
 namespace Anticipator
 {
-    class Listener : public TCP::Service
+    class Session;
+
+    class Listener : public Primus::SharedListener
     {
-        typedef TCP::Service Inherited;
+        typedef Primus::SharedListener Inherited;
 
     private:
         /**
-         * Thread handler of service thread.
+         * Thread handlers of acceptor threads.
          */
-        std::thread thread;
+        std::vector<std::thread> threads;
 
     public:
         Listener(
             const IP::Family        family,
-            const unsigned short    portNumber);
+            const unsigned short    portNumber,
+            const unsigned int      numberOfAcceptors);
 
     private:
+        Anticipator::Session*
+        acceptSession(const unsigned long generation);
+
         static void
         ThreadHandler(Anticipator::Listener*);
     };
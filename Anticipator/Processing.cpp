@@ -4,17 +4,19 @@
 #include <cstring>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
 // Common definition files.
 //
 #include "APNS/APNS.hpp"
-#include "PostgreSQL/PostgreSQL.hpp"
 #include "RTSP/RTSP.hpp"
 #include "Toolkit/Report.h"
 
 // Local definition files.
 //
 #include "Primus/Configuration.hpp"
+#include "Primus/Statements.hpp"
+#include "Primus/UUID.hpp"
 #include "Primus/Anticipator/Session.hpp"
 #include "Primus/Database/Fabulas.hpp"
 #include "Primus/Database/Phoenix.hpp"
@@ -22,119 +24,124 @@
 #include "Primus/Database/Servus.hpp"
 #include "Primus/Database/Servuses.hpp"
 
+/**
+ * Methods known to anticipator. Looked up once per datagram.
+ */
+static const std::unordered_map<std::string, Anticipator::Method> Methods =
+{
+    { "ACTIVATE",           { &Anticipator::Session::handleActivate,        false } },
+    { "APNS",               { &Anticipator::Session::handleAPNS,            true } },
+    { "LOGIN",              { &Anticipator::Session::handleLogin,           false } },
+    { "QUASAR-LIST",        { &Anticipator::Session::handleServusList,      true } },
+    { "FABULA-LIST",        { &Anticipator::Session::handleFabulaList,      true } }
+};
+
+/**
+ * @brief   Find handler for request method and call it.
+ */
 void
-Anticipator::Session::handleActivate()
+Anticipator::Session::handleDatagram()
 {
-    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+    auto method = Methods.find(this->request.method());
+    if (method == Methods.end())
+    {
+        this->handleUnknown();
 
-    std::this_thread::sleep_for(std::chrono::milliseconds
-            { configuration.phoenix.delayResponseForActivate } );
+        return;
+    }
 
-    try
+    if ((method->second.loginRequired == true) && (this->phoenix == nullptr))
     {
-        const std::string softwareVersion = this->request["Software-Version"];
-        const std::string activationCode = this->request["Activation-Code"];
-        const std::string vendorToken = this->request["Vendor-Token"];
-        const std::string deviceName = this->request["Device-Name"];
-        const std::string deviceModel = this->request["Device-Model"];
+        this->loginRequired();
 
-        if (softwareVersion.length() == 0)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds
-                    { configuration.phoenix.delayResponseForRejected } );
+        return;
+    }
 
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Missing software version";
-            this->response.generateResponse(RTSP::BadRequest);
+    (this->*method->second.handler)();
+}
 
-            throw Anticipator::RejectDatagram("Missing software version");
-        }
+void
+Anticipator::Session::handleActivate()
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
 
-        if (activationCode.length() != Primus::ActivationCodeLength)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds
-                    { configuration.phoenix.delayResponseForRejected } );
+    std::this_thread::sleep_for(std::chrono::milliseconds
+            { configuration.phoenix.delayResponseForActivate } );
 
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Activation code in wrong format";
-            this->response.generateResponse(RTSP::NotAcceptable);
+    Primus::StatementView softwareVersion;
+    Primus::StatementView activationCode;
+    Primus::StatementView vendorToken;
+    Primus::StatementView deviceName;
+    Primus::StatementView deviceModel;
+
+    if ((this->statements.find("Software-Version", softwareVersion) == false) ||
+        (this->statements.find("Activation-Code", activationCode) == false) ||
+        (this->statements.find("Vendor-Token", vendorToken) == false) ||
+        (this->statements.find("Device-Name", deviceName) == false) ||
+        (this->statements.find("Device-Model", deviceModel) == false))
+    {
+        this->missingStatements();
+    }
 
-            throw Anticipator::RejectDatagram("Activation code in wrong format");
-        }
+    if (softwareVersion.empty() == true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds
+                { configuration.phoenix.delayResponseForRejected } );
 
-        if (vendorToken.length() != PostgreSQL::UUIDPlainLength)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds
-                    { configuration.phoenix.delayResponseForRejected } );
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Missing software version";
+        this->response.generateResponse(RTSP::BadRequest);
 
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Bad ventor token";
-            this->response.generateResponse(RTSP::BadRequest);
+        throw Anticipator::RejectDatagram("Missing software version");
+    }
 
-            throw Anticipator::RejectDatagram("Bad ventor token");
-        }
+    if (activationCode.length != Primus::ActivationCodeLength)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds
+                { configuration.phoenix.delayResponseForRejected } );
 
-        if (deviceName.length() == 0)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds
-                    { configuration.phoenix.delayResponseForRejected } );
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Activation code in wrong format";
+        this->response.generateResponse(RTSP::NotAcceptable);
 
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Missing device name";
-            this->response.generateResponse(RTSP::BadRequest);
+        throw Anticipator::RejectDatagram("Activation code in wrong format");
+    }
 
-            throw Anticipator::RejectDatagram("Missing device name");
-        }
+    Primus::UUID vendorUUID;
 
-        if (deviceModel.length() == 0)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds
-                    { configuration.phoenix.delayResponseForRejected } );
+    if (vendorUUID.parse(vendorToken.data, vendorToken.length) == false)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds
+                { configuration.phoenix.delayResponseForRejected } );
 
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Missing device model";
-            this->response.generateResponse(RTSP::BadRequest);
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Bad ventor token";
+        this->response.generateResponse(RTSP::BadRequest);
 
-            throw Anticipator::RejectDatagram("Missing device model");
-        }
+        throw Anticipator::RejectDatagram("Bad ventor token");
+    }
 
-        unsigned long phoenixId = Database::Phoenix::RegisterPhoenixWithActivationCode(
-                activationCode,
-                vendorToken,
-                deviceName,
-                deviceModel,
-                softwareVersion,
-                deviceName);
+    if (deviceName.empty() == true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds
+                { configuration.phoenix.delayResponseForRejected } );
 
-        if (phoenixId == 0)
-        {
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response.generateResponse(RTSP::NotFound);
-        }
-        else
-        {
-            this->phoenix = &Database::Phoenixes::PhoenixById(phoenixId);
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Missing device name";
+        this->response.generateResponse(RTSP::BadRequest);
 
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Walker-Token"] = this->phoenix->token;
-            this->response.generateResponse(RTSP::OK);
-        }
+        throw Anticipator::RejectDatagram("Missing device name");
     }
-    catch (RTSP::StatementNotFound& exception)
+
+    if (deviceModel.empty() == true)
     {
         std::this_thread::sleep_for(std::chrono::milliseconds
                 { configuration.phoenix.delayResponseForRejected } );
@@ -142,24 +149,48 @@ Anticipator::Session::handleActivate()
         this->response.reset();
         this->response["CSeq"] = this->expectedCSeq;
         this->response["Agent"] = Primus::SoftwareVersion;
-        this->response["Reason"] = "Missing mandatory statements";
+        this->response["Reason"] = "Missing device model";
         this->response.generateResponse(RTSP::BadRequest);
 
-        throw Anticipator::RejectDatagram("Missing statements");
+        throw Anticipator::RejectDatagram("Missing device model");
+    }
+
+    unsigned long phoenixId = Database::Phoenix::RegisterPhoenixWithActivationCode(
+            activationCode.asString(),
+            vendorUUID,
+            deviceName.asString(),
+            deviceModel.asString(),
+            softwareVersion.asString(),
+            deviceName.asString());
+
+    if (phoenixId == 0)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response.generateResponse(RTSP::NotFound);
+    }
+    else
+    {
+        this->phoenix.reset(new Database::Phoenix(phoenixId));
+
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Walker-Token"] = this->phoenix->token.asString();
+        this->response.generateResponse(RTSP::OK);
     }
 }
 
 void
 Anticipator::Session::handleAPNS()
 {
-    if (this->phoenix == nullptr)
-    {
-        this->loginRequired();
+    Primus::StatementView deviceTokenView;
 
-        return;
-    }
+    if (this->statements.find("Device-Token", deviceTokenView) == false)
+        this->missingStatements();
 
-    const std::string deviceToken = this->request["Device-Token"];
+    const std::string deviceToken = deviceTokenView.asString();
 
     char t[72];
     APNS::DeviceTokenFromString(t, deviceToken.c_str());
@@ -181,82 +212,70 @@ Anticipator::Session::handleLogin()
     std::this_thread::sleep_for(std::chrono::milliseconds
             { configuration.phoenix.delayResponseForLogin } );
 
-    try
-    {
-        const std::string phoenixToken = this->request["Walker-Token"];
-        const std::string softwareVersion = this->request["Software-Version"];
-
-        if (phoenixToken.length() == 0)
-        {
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Bad phoenix token";
-            this->response.generateResponse(RTSP::BadRequest);
-
-            throw Anticipator::RejectDatagram("Bad phoenix token");
-        }
-
-        if (phoenixToken.length() != PostgreSQL::UUIDPlainLength)
-        {
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Phoenix token in wrong format";
-            this->response.generateResponse(RTSP::BadRequest);
+    Primus::StatementView phoenixToken;
+    Primus::StatementView softwareVersion;
 
-            throw Anticipator::RejectDatagram("Phoenix token in wrong format");
-        }
-
-        if (softwareVersion.length() == 0)
-        {
-            this->response.reset();
-            this->response["CSeq"] = this->expectedCSeq;
-            this->response["Agent"] = Primus::SoftwareVersion;
-            this->response["Reason"] = "Missing software version";
-            this->response.generateResponse(RTSP::BadRequest);
+    if ((this->statements.find("Walker-Token", phoenixToken) == false) ||
+        (this->statements.find("Software-Version", softwareVersion) == false))
+    {
+        this->missingStatements();
+    }
 
-            throw Anticipator::RejectDatagram("Missing software version");
-        }
+    if (phoenixToken.empty() == true)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Bad phoenix token";
+        this->response.generateResponse(RTSP::BadRequest);
 
-        this->phoenix = &Database::Phoenixes::PhoenixByToken(phoenixToken);
+        throw Anticipator::RejectDatagram("Bad phoenix token");
+    }
 
-        this->phoenix->setSoftwareVersion(softwareVersion);
+    Primus::UUID phoenixUUID;
 
+    if (phoenixUUID.parse(phoenixToken.data, phoenixToken.length) == false)
+    {
         this->response.reset();
         this->response["CSeq"] = this->expectedCSeq;
         this->response["Agent"] = Primus::SoftwareVersion;
-        this->response.generateResponse(RTSP::OK);
+        this->response["Reason"] = "Phoenix token in wrong format";
+        this->response.generateResponse(RTSP::BadRequest);
+
+        throw Anticipator::RejectDatagram("Phoenix token in wrong format");
     }
-    catch (RTSP::StatementNotFound& exception)
-    {
-        std::this_thread::sleep_for(std::chrono::milliseconds
-                { configuration.phoenix.delayResponseForRejected } );
 
+    if (softwareVersion.empty() == true)
+    {
         this->response.reset();
         this->response["CSeq"] = this->expectedCSeq;
         this->response["Agent"] = Primus::SoftwareVersion;
-        this->response["Reason"] = "Missing mandatory statements";
+        this->response["Reason"] = "Missing software version";
         this->response.generateResponse(RTSP::BadRequest);
 
-        throw Anticipator::RejectDatagram("Missing statements");
+        throw Anticipator::RejectDatagram("Missing software version");
     }
+
+    this->phoenix.reset(new Database::Phoenix(
+            Database::Phoenixes::PhoenixByToken(phoenixUUID)));
+
+    this->phoenix->setSoftwareVersion(softwareVersion.asString());
+
+    this->response.reset();
+    this->response["CSeq"] = this->expectedCSeq;
+    this->response["Agent"] = Primus::SoftwareVersion;
+    this->response.generateResponse(RTSP::OK);
 }
 
 void
 Anticipator::Session::handleServusList()
 {
-    if (this->phoenix == nullptr)
-    {
-        this->loginRequired();
-
-        return;
-    }
-
     this->response.reset();
     this->response["CSeq"] = this->expectedCSeq;
     this->response["Agent"] = Primus::SoftwareVersion;
 
+    // Online status in database lags behind by at most one synchronization interval.
+    //
     const std::string payload =
             Database::Servuses::ServusesAsXML();
 
@@ -266,19 +285,14 @@ Anticipator::Session::handleServusList()
 void
 Anticipator::Session::handleFabulaList()
 {
-    if (this->phoenix == nullptr)
-    {
-        this->loginRequired();
-
-        return;
-    }
-
 #if 0
     try
     {
         const std::string lastKnownFabulaToken = this->request["Last-Known"];
 
-        if (lastKnownFabulaToken.length() != PostgreSQL::UUIDPlainLength)
+        Primus::UUID lastKnownFabulaUUID;
+
+        if (lastKnownFabulaUUID.parse(lastKnownFabulaToken.data(), lastKnownFabulaToken.length()) == false)
         {
             this->response.reset();
             this->response["CSeq"] = this->expectedCSeq;
@@ -297,7 +311,7 @@ Anticipator::Session::handleFabulaList()
 
         const std::string payload =
                 Database::Fabulas::FabulasAsXML(
-                        lastKnownFabulaToken,
+                        lastKnownFabulaUUID,
                         Primus::MaximalNumberOfFabulasPerXML);
 
         this->response.generateResponse(RTSP::OK, payload);
@@ -314,7 +328,7 @@ Anticipator::Session::handleFabulaList()
 
         const std::string payload =
                 Database::Fabulas::FabulasAsXML(
-                        "",
+                        Primus::UUID(),
                         Primus::MaximalNumberOfFabulasPerXML);
 
         this->response.generateResponse(RTSP::OK, payload);
@@ -350,3 +364,25 @@ Anticipator::Session::loginRequired()
     this->response["Reason"] = "Session not authenticated";
     this->response.generateResponse(RTSP::Forbidden);
 }
+
+/**
+ * @brief   Reject request lacking any of the statements its method requires.
+ *
+ * @throw   Anticipator::RejectDatagram     Always.
+ */
+void
+Anticipator::Session::missingStatements()
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds
+            { configuration.phoenix.delayResponseForRejected } );
+
+    this->response.reset();
+    this->response["CSeq"] = this->expectedCSeq;
+    this->response["Agent"] = Primus::SoftwareVersion;
+    this->response["Reason"] = "Missing mandatory statements";
+    this->response.generateResponse(RTSP::BadRequest);
+
+    throw Anticipator::RejectDatagram("Missing statements");
+}
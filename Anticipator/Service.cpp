@@ -45,11 +45,13 @@ Anticipator::Service::Service()
 
     this->listenerIPv4 = new Anticipator::Listener(
             IP::IPv4,
-            configuration.phoenix.portNumberIPv4);
+            configuration.phoenix.portNumberIPv4,
+            configuration.phoenix.numberOfAcceptors);
 
     this->listenerIPv6 = new Anticipator::Listener(
             IP::IPv6,
-            configuration.phoenix.portNumberIPv6);
+            configuration.phoenix.portNumberIPv6,
+            configuration.phoenix.numberOfAcceptors);
 }
 
 const std::string
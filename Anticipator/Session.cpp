@@ -18,6 +18,7 @@
 // Local definition files.
 //
 #include "Primus/Configuration.hpp"
+#include "Primus/ReceiveBuffers.hpp"
 #include "Primus/Anticipator/Session.hpp"
 #include "Primus/Database/Debug.hpp"
 
@@ -32,22 +33,10 @@ response()
     this->expectedCSeq = 1;
 
     this->phoenix = nullptr;
-
-    // Allocate resources to be used for receive buffer.
-    //
-    this->receiveBuffer = (char*) malloc(Anticipator::BytesReceivePerStep);
-    if (this->receiveBuffer == NULL)
-    {
-        ReportSoftAlert("[Anticipator] Out of memory");
-
-        throw std::runtime_error("[Anticipator] Out of memory");
-    }
 }
 
 Anticipator::Session::~Session()
-{
-    free(this->receiveBuffer);
-}
+{ }
 
 void
 Anticipator::Session::ThreadHandler(Anticipator::Session* session)
@@ -98,19 +87,26 @@ Anticipator::Session::ThreadHandler(Anticipator::Session* session)
     {
         session->request.reset();
 
+        // Datagram is first received into a small buffer and continued with large buffers
+        // if it does not fit. Buffer is held only while receiving a chunk.
+        //
+        Primus::ReceiveBufferClass receiveBufferClass = Primus::SmallReceiveBuffer;
+
         // Receive datagram chunks continuously until either complete datagram is received
         // or timeout ocures.
         //
         for (;;)
         {
+            Primus::ReceiveBuffer receiveBuffer { receiveBufferClass };
+
             unsigned int receivedBytes;
 
             try
             {
                 receivedBytes = Communicator::Receive(
                         session->socket(),
-                        session->receiveBuffer,
-                        Anticipator::BytesReceivePerStep);
+                        receiveBuffer.data,
+                        receiveBuffer.size);
             }
             catch (Communicator::TransmissionError& exception)
             {
@@ -136,7 +132,7 @@ Anticipator::Session::ThreadHandler(Anticipator::Session* session)
 
             try
             {
-                session->request.push(session->receiveBuffer, receivedBytes);
+                session->request.push(receiveBuffer.data, receivedBytes);
             }
             catch (std::exception& exception)
             {
@@ -150,6 +146,11 @@ Anticipator::Session::ThreadHandler(Anticipator::Session* session)
                 break;
             }
 
+            if (receivedBytes == receiveBuffer.size)
+            {
+                receiveBufferClass = Primus::LargeReceiveBuffer;
+            }
+
             // Wait until next chunk of datagram is available.
             // Cancel session in case of timeout.
             //
@@ -177,27 +178,29 @@ Anticipator::Session::ThreadHandler(Anticipator::Session* session)
             }
         }
 
+        session->statements.index(session->request.contentBuffer, session->request.contentLength);
+
         try
         {
-            try
-            {
-                const unsigned int providedCSeq = session->request["CSeq"];
+            Primus::StatementView cseq;
+            unsigned int providedCSeq;
 
-                if (providedCSeq != session->expectedCSeq)
-                {
-                    std::this_thread::sleep_for(std::chrono::milliseconds
-                            { configuration.phoenix.delayResponseForRejected } );
+            const char* cseqReason = NULL;
 
-                    session->response.reset();
-                    session->response["CSeq"] = session->expectedCSeq;
-                    session->response["Agent"] = Primus::SoftwareVersion;
-                    session->response["Reason"] = "Unexpected CSeq";
-                    session->response.generateResponse(RTSP::BadRequest);
-
-                    throw Anticipator::RejectDatagram("Unexpected CSeq");
-                }
+            if (session->statements.find("CSeq", cseq) == false)
+            {
+                cseqReason = "Missing CSeq";
             }
-            catch (RTSP::StatementNotFound& exception)
+            else if (Primus::ParseUnsigned(cseq, providedCSeq) == false)
+            {
+                cseqReason = "Bad CSeq";
+            }
+            else if (providedCSeq != session->expectedCSeq)
+            {
+                cseqReason = "Unexpected CSeq";
+            }
+
+            if (cseqReason != NULL)
             {
                 std::this_thread::sleep_for(std::chrono::milliseconds
                         { configuration.phoenix.delayResponseForRejected } );
@@ -205,36 +208,13 @@ Anticipator::Session::ThreadHandler(Anticipator::Session* session)
                 session->response.reset();
                 session->response["CSeq"] = session->expectedCSeq;
                 session->response["Agent"] = Primus::SoftwareVersion;
-                session->response["Reason"] = "Missing CSeq";
+                session->response["Reason"] = cseqReason;
                 session->response.generateResponse(RTSP::BadRequest);
 
-                throw Anticipator::RejectDatagram("Missing CSeq");
+                throw Anticipator::RejectDatagram(cseqReason);
             }
 
-            if (session->request.methodIs("ACTIVATE") == true)
-            {
-                session->handleActivate();
-            }
-            else if (session->request.methodIs("APNS") == true)
-            {
-                session->handleAPNS();
-            }
-            else if (session->request.methodIs("LOGIN") == true)
-            {
-                session->handleLogin();
-            }
-            else if (session->request.methodIs("QUASAR-LIST") == true)
-            {
-                session->handleServusList();
-            }
-            else if (session->request.methodIs("FABULA-LIST") == true)
-            {
-                session->handleFabulaList();
-            }
-            else
-            {
-                session->handleUnknown();
-            }
+            session->handleDatagram();
         }
         catch (APNS::BrokenDeviceToken& exception)
         {
@@ -2,6 +2,7 @@
 
 // System definition files.
 //
+#include <memory>
 #include <stdexcept>
 
 // Common definition files.
@@ -11,24 +12,39 @@
 
 // Local definition files.
 //
+#include "Primus/Statements.hpp"
 #include "Primus/Database/Phoenix.hpp"
 
 namespace Anticipator
 {
-    static const unsigned int BytesReceivePerStep = 64 * 1024;
+    class Session;
+
+    typedef void (Anticipator::Session::*MethodHandler)();
+
+    /**
+     * Entry of method table - handler of a method and whether it may be called
+     * only after phoenix has logged in.
+     */
+    struct Method
+    {
+        Anticipator::MethodHandler  handler;
+        bool                        loginRequired;
+    };
 
     class Session : public TCP::Connection
     {
         typedef TCP::Connection Inherited;
 
-    private:
-        char*               receiveBuffer;
-
     public:
         RTSP::Datagram      request;
         RTSP::Datagram      response;
         unsigned int        expectedCSeq;
-        Database::Phoenix*  phoenix;
+        std::unique_ptr<Database::Phoenix>  phoenix;
+
+        /**
+         * Statements of request, looked up in place.
+         */
+        Primus::Statements  statements;
 
     public:
         Session(TCP::Service&);
@@ -39,13 +55,15 @@ namespace Anticipator
         ThreadHandler(Anticipator::Session*);
 
         void
+        handleDatagram(),
         handleActivate(),
         handleAPNS(),
         handleLogin(),
         handleServusList(),
         handleFabulaList(),
         handleUnknown(),
-        loginRequired();
+        loginRequired(),
+        missingStatements();
     };
 
     class RejectDatagram : public std::runtime_error
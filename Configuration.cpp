@@ -44,7 +44,15 @@ configurationFilePath(configurationFilePath)
     this->servus.waitForFirstDatagram               = Primus::DefaultServusWaitForFirstDatagram;
     this->servus.waitForDatagramCompletion          = Primus::DefaultServusWaitForDatagramCompletion;
     this->servus.intervalBetweenNeutrinos           = Primus::DefaultServusIntervalBetweenNeutrinos;
+    this->servus.throttledIntervalBetweenNeutrinos  = Primus::DefaultServusThrottledIntervalBetweenNeutrinos;
     this->servus.finalWaitForNeutrino               = Primus::DefaultServusFinalWaitForNeutrino;
+    this->servus.engine                             = Primus::ThreadPerSession;
+    this->servus.numberOfEventLoops                 = Primus::DefaultServusNumberOfEventLoops;
+    this->servus.numberOfAcceptors                  = Primus::DefaultServusNumberOfAcceptors;
+    this->servus.addressDatagramRate                = Primus::DefaultServusAddressDatagramRate;
+    this->servus.addressDatagramBurst               = Primus::DefaultServusAddressDatagramBurst;
+    this->servus.datagramRate                       = Primus::DefaultServusDatagramRate;
+    this->servus.datagramBurst                      = Primus::DefaultServusDatagramBurst;
 
     this->phoenix.portNumberIPv4                    = Primus::DefaultPhoenixPortNumberIPv4;
     this->phoenix.portNumberIPv6                    = Primus::DefaultPhoenixPortNumberIPv6;
@@ -54,6 +62,20 @@ configurationFilePath(configurationFilePath)
     this->phoenix.delayResponseForLogin             = Primus::DefaultPhoenixDelayResponseForLogin;
     this->phoenix.delayResponseForRejected          = Primus::DefaultPhoenixDelayResponseForRejected;
     this->phoenix.keepAlive                         = Primus::DefaultPhoenixKeepAlive;
+    this->phoenix.numberOfAcceptors                 = Primus::DefaultPhoenixNumberOfAcceptors;
+
+    this->ingest.maximalBatchSize                   = Primus::DefaultIngestMaximalBatchSize;
+    this->ingest.maximalBatchDelay                  = Primus::DefaultIngestMaximalBatchDelay;
+    this->ingest.throttleQueuedReadings             = Primus::DefaultIngestThrottleQueuedReadings;
+    this->ingest.throttleDepositLatency             = Primus::DefaultIngestThrottleDepositLatency;
+    this->ingest.throttleSpoolBacklog               = Primus::DefaultIngestThrottleSpoolBacklog;
+    this->ingest.maximalQueuedReadings              = Primus::DefaultIngestMaximalQueuedReadings;
+    this->ingest.maximalQueuedAvisos                = Primus::DefaultIngestMaximalQueuedAvisos;
+
+    this->spool.enabled                             = false;
+    this->spool.filePath                            = Primus::DefaultSpoolFilePath;
+    this->spool.maximalSyncDelay                    = Primus::DefaultSpoolMaximalSyncDelay;
+    this->spool.retryInterval                       = Primus::DefaultSpoolRetryInterval;
 
     this->apns.delayAfterWakeup                     = Primus::DefaultDelayAfterWakeup;
     this->apns.delayBetweenFrames                   = Primus::DefaultDelayBetweenFrames;
@@ -23,7 +23,14 @@ namespace Primus
     static const unsigned DefaultServusWaitForFirstDatagram         = 5000;     /**< Milliseconds. */
     static const unsigned DefaultServusWaitForDatagramCompletion    = 2000;     /**< Milliseconds. */
     static const unsigned DefaultServusIntervalBetweenNeutrinos     = 30000;    /**< Milliseconds. */
+    static const unsigned DefaultServusThrottledIntervalBetweenNeutrinos = 120000;  /**< Milliseconds. */
     static const unsigned DefaultServusFinalWaitForNeutrino         = 2000;     /**< Milliseconds. */
+    static const unsigned DefaultServusNumberOfEventLoops           = 4;
+    static const unsigned DefaultServusNumberOfAcceptors            = 1;
+    static const unsigned DefaultServusAddressDatagramRate          = 50;       /**< Datagrams per second. */
+    static const unsigned DefaultServusAddressDatagramBurst         = 200;      /**< Datagrams. */
+    static const unsigned DefaultServusDatagramRate                 = 20;       /**< Datagrams per second. */
+    static const unsigned DefaultServusDatagramBurst                = 100;      /**< Datagrams. */
 
     static const unsigned DefaultPhoenixWaitForFirstDatagram        = 5000;     /**< Milliseconds. */
     static const unsigned DefaultPhoenixWaitForDatagramCompletion   = 2000;     /**< Milliseconds. */
@@ -31,12 +38,39 @@ namespace Primus
     static const unsigned DefaultPhoenixDelayResponseForLogin       = 200;      /**< Milliseconds. */
     static const unsigned DefaultPhoenixDelayResponseForRejected    = 1000;      /**< Milliseconds. */
     static const unsigned DefaultPhoenixKeepAlive                   = 300000;   /**< Milliseconds. */
+    static const unsigned DefaultPhoenixNumberOfAcceptors           = 1;
+
+    static const unsigned DefaultIngestMaximalBatchSize             = 200;      /**< Readings. */
+    static const unsigned DefaultIngestMaximalBatchDelay            = 50;       /**< Milliseconds. */
+    static const unsigned DefaultIngestThrottleQueuedReadings       = 10000;    /**< Readings. */
+    static const unsigned DefaultIngestThrottleDepositLatency       = 2000;     /**< Milliseconds. */
+    static const unsigned DefaultIngestThrottleSpoolBacklog         = 64 * 1024 * 1024; /**< Bytes. */
+    static const unsigned DefaultIngestMaximalQueuedReadings        = 100000;   /**< Readings. */
+    static const unsigned DefaultIngestMaximalQueuedAvisos          = 1000;     /**< Avisos. */
+
+    static const std::string DefaultSpoolFilePath                   = "/opt/castellum/primus.spool";
+    static const unsigned DefaultSpoolMaximalSyncDelay              = 5;        /**< Milliseconds. */
+    static const unsigned DefaultSpoolRetryInterval                 = 5000;     /**< Milliseconds. */
+
+    /**
+     * Every reading takes four query parameters and PostgreSQL accepts at most 65535 of them.
+     */
+    static const unsigned int MaximalIngestBatchSize                = 65535 / 4;
 
     static const unsigned DefaultDelayAfterWakeup                   = 500;      /**< Milliseconds. */
     static const unsigned DefaultDelayBetweenFrames                 = 100;      /**< Milliseconds. */
     static const unsigned DefaultDelayAfterCompletion               = 500;      /**< Milliseconds. */
     static const unsigned DefaultPauseBeforeReconnect               = 10;
 
+    /**
+     * Way servus sessions are driven by dispatcher.
+     */
+    enum ServusEngine
+    {
+        ThreadPerSession,   /**< Every session runs in its own thread. */
+        EventDriven         /**< Sessions are multiplexed by a set of epoll event loops. */
+    };
+
     static const unsigned int ActivationCodeLength                  = 10;
 
     static const unsigned int MaximalNumberOfFabulasPerXML          = 20;
@@ -71,7 +105,15 @@ namespace Primus
             unsigned int        waitForFirstDatagram;
             unsigned int        waitForDatagramCompletion;
             unsigned int        intervalBetweenNeutrinos;
+            unsigned int        throttledIntervalBetweenNeutrinos;
             unsigned int        finalWaitForNeutrino;
+            ServusEngine        engine;
+            unsigned int        numberOfEventLoops;
+            unsigned int        numberOfAcceptors;      /**< Accepting threads per port. */
+            unsigned int        addressDatagramRate;    /**< Datagrams per second from one remote address, zero if not limited. */
+            unsigned int        addressDatagramBurst;
+            unsigned int        datagramRate;           /**< Datagrams per second from one servus, zero if not limited. */
+            unsigned int        datagramBurst;
         }
         servus;
 
@@ -86,9 +128,31 @@ namespace Primus
             unsigned int        delayResponseForLogin;
             unsigned int        delayResponseForRejected;
             unsigned int        keepAlive;
+            unsigned int        numberOfAcceptors;      /**< Accepting threads per port. */
         }
         phoenix;
 
+        struct
+        {
+            unsigned int        maximalBatchSize;
+            unsigned int        maximalBatchDelay;
+            unsigned int        throttleQueuedReadings;
+            unsigned int        throttleDepositLatency;
+            unsigned int        throttleSpoolBacklog;
+            unsigned int        maximalQueuedReadings;  /**< Deposits beyond it are declined. */
+            unsigned int        maximalQueuedAvisos;
+        }
+        ingest;
+
+        struct
+        {
+            bool                enabled;
+            std::string         filePath;
+            unsigned int        maximalSyncDelay;
+            unsigned int        retryInterval;
+        }
+        spool;
+
         struct
         {
             bool                sandbox;
@@ -31,30 +31,8 @@ Database::Activator::Activator(const unsigned long activatorId)
         query.execute(QuerySearchForActivatorById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(6);
-        query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(1, PostgreSQL::INT8OID);
-        query.assertColumnOfType(2, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(3, PostgreSQL::INT8OID);
-        query.assertColumnOfType(4, PostgreSQL::VARCHAROID);
-        query.assertColumnOfType(5, PostgreSQL::VARCHAROID);
-
-        this->timestamp         = query.popTIMESTAMP();
-        this->activatorId       = query.popBIGINT();
-        this->activatorToken    = query.popUUID();
-
-        if (query.cellIsNull() == true)
-        {
-            this->phoenixId = 0;
-            query.nextColumn();
-        }
-        else
-        {
-            this->phoenixId = query.popBIGINT();
-        }
 
-        this->activationCode = query.popVARCHAR();
-        this->title = query.popVARCHAR();
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -71,12 +49,41 @@ Database::Activator::Activator(const unsigned long activatorId)
     }
 }
 
-Database::Activator::~Activator()
+/**
+ * @brief   Load activator from current row of a query selecting the same columns as by id.
+ */
+Database::Activator::Activator(PostgreSQL::Query& query)
 {
-    if (this->timestamp != NULL)
+    this->loadRow(query);
+}
+
+void
+Database::Activator::loadRow(PostgreSQL::Query& query)
+{
+    query.assertNumberOfColumns(6);
+    query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(1, PostgreSQL::INT8OID);
+    query.assertColumnOfType(2, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(3, PostgreSQL::INT8OID);
+    query.assertColumnOfType(4, PostgreSQL::VARCHAROID);
+    query.assertColumnOfType(5, PostgreSQL::VARCHAROID);
+
+    this->timestamp         = Primus::PopTimestamp(query);
+    this->activatorId       = query.popBIGINT();
+    this->activatorToken    = Primus::UUID::FromString(query.popUUID());
+
+    if (query.cellIsNull() == true)
     {
-        delete this->timestamp;
+        this->phoenixId = 0;
+        query.nextColumn();
     }
+    else
+    {
+        this->phoenixId = query.popBIGINT();
+    }
+
+    this->activationCode = query.popVARCHAR();
+    this->title = query.popVARCHAR();
 }
 
 void
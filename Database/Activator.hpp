@@ -6,16 +6,21 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class Activator
     {
     public:
-        Toolkit::Timestamp* timestamp;
+        Toolkit::Timestamp  timestamp;
         unsigned long       activatorId;
-        std::string         activatorToken;
+        Primus::UUID        activatorToken;
         unsigned long       phoenixId;
         std::string         activationCode;
         std::string         title;
@@ -23,7 +28,7 @@ namespace Database
     public:
         Activator(const unsigned long activatorId);
 
-        ~Activator();
+        Activator(PostgreSQL::Query& query);
 
         void
         setActivationCode(const std::string&);
@@ -35,5 +40,9 @@ namespace Database
         DefineActivator(
             const std::string&  activationCode,
             const std::string&  title);
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
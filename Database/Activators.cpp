@@ -10,6 +10,7 @@
 // Local definition files.
 //
 #include "Primus/Database/Database.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Activator.hpp"
 #include "Primus/Database/Activators.hpp"
 #include "Primus/Database/Queries/Activator.h"
@@ -52,7 +53,7 @@ Database::Activators::TotalNumber()
     return numberOfActivators;
 }
 
-Database::Activator&
+Database::Activator
 Database::Activators::ActivatorByIndex(const unsigned long activatorIndex)
 {
     unsigned long activatorId;
@@ -93,10 +94,50 @@ Database::Activators::ActivatorByIndex(const unsigned long activatorIndex)
     return Database::Activators::ActivatorById(activatorId);
 }
 
-Database::Activator&
+Database::Activator
 Database::Activators::ActivatorById(const unsigned long activatorId)
 {
-    Database::Activator* activator = new Database::Activator(activatorId);
+    return Database::Activator(activatorId);
+}
+
+/**
+ * @brief   Load all activators with one query, in the order they are listed.
+ */
+Database::EntityList<Database::Activator>
+Database::Activators::AllActivators()
+{
+    Database::EntityList<Database::Activator> activators;
+
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        PostgreSQL::Query query(database.connection());
+
+        query.execute(QueryAllActivators);
+
+        while (query.reachedLastRow() == false)
+        {
+            activators.emplace_back(query);
+
+            query.nextRow();
+        }
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot load list of activators: %s",
+                exception.what());
+
+        throw exception;
+    }
 
-    return *activator;
+    return activators;
 }
@@ -2,6 +2,7 @@
 
 // Local definition files.
 //
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Activator.hpp"
 
 namespace Database
@@ -12,10 +13,13 @@ namespace Database
         static unsigned long
         TotalNumber();
 
-        static Database::Activator&
+        static Database::Activator
         ActivatorByIndex(const unsigned long);
 
-        static Database::Activator&
+        static Database::Activator
         ActivatorById(const unsigned long);
+
+        static Database::EntityList<Database::Activator>
+        AllActivators();
     };
 };
@@ -30,24 +30,8 @@ Database::DHTSensor::DHTSensor(const unsigned long sensorId)
         query.execute(QuerySearchForDHTSensorById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(8);
-        query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(1, PostgreSQL::INT8OID);
-        query.assertColumnOfType(2, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(3, PostgreSQL::INT8OID);
-        query.assertColumnOfType(4, PostgreSQL::INT2OID);
-        query.assertColumnOfType(5, PostgreSQL::FLOAT4OID);
-        query.assertColumnOfType(6, PostgreSQL::FLOAT4OID);
-        query.assertColumnOfType(7, PostgreSQL::VARCHAROID);
-
-        this->timestamp         = query.popTIMESTAMP();
-        this->sensorId          = query.popBIGINT();
-        this->token             = query.popUUID();
-        this->servusId          = query.popBIGINT();
-        this->gpioPinNumber     = query.popSMALL();
-        this->humidityEdge      = query.popREAL();
-        this->temperatureEdge   = query.popREAL();
-        this->title             = query.popVARCHAR();
+
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -64,12 +48,35 @@ Database::DHTSensor::DHTSensor(const unsigned long sensorId)
     }
 }
 
-Database::DHTSensor::~DHTSensor()
+/**
+ * @brief   Load DHT11/DHT22 sensor from current row of a query selecting the same columns as by id.
+ */
+Database::DHTSensor::DHTSensor(PostgreSQL::Query& query)
 {
-    if (this->timestamp != NULL)
-    {
-        delete this->timestamp;
-    }
+    this->loadRow(query);
+}
+
+void
+Database::DHTSensor::loadRow(PostgreSQL::Query& query)
+{
+    query.assertNumberOfColumns(8);
+    query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(1, PostgreSQL::INT8OID);
+    query.assertColumnOfType(2, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(3, PostgreSQL::INT8OID);
+    query.assertColumnOfType(4, PostgreSQL::INT2OID);
+    query.assertColumnOfType(5, PostgreSQL::FLOAT4OID);
+    query.assertColumnOfType(6, PostgreSQL::FLOAT4OID);
+    query.assertColumnOfType(7, PostgreSQL::VARCHAROID);
+
+    this->timestamp         = Primus::PopTimestamp(query);
+    this->sensorId          = query.popBIGINT();
+    this->token             = Primus::UUID::FromString(query.popUUID());
+    this->servusId          = query.popBIGINT();
+    this->gpioPinNumber     = query.popSMALL();
+    this->humidityEdge      = query.popREAL();
+    this->temperatureEdge   = query.popREAL();
+    this->title             = query.popVARCHAR();
 }
 
 float
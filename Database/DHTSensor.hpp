@@ -6,16 +6,21 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class DHTSensor
     {
     public:
-        Toolkit::Timestamp* timestamp;
+        Toolkit::Timestamp  timestamp;
         unsigned long       sensorId;
-        std::string         token;
+        Primus::UUID        token;
         unsigned long       servusId;
         std::string         gpioPinNumber;
         float               humidityEdge;
@@ -25,7 +30,7 @@ namespace Database
     public:
         DHTSensor(const unsigned long sensorId);
 
-        ~DHTSensor();
+        DHTSensor(PostgreSQL::Query& query);
 
         float
         lastKnownHumidity(),
@@ -36,5 +41,9 @@ namespace Database
         lastKnownTemperature(),
         lowestKnownTemperature(),
         highestKnownTemperature();
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
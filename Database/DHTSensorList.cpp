@@ -12,6 +12,7 @@
 // Local definition files.
 //
 #include "Primus/Database/Database.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/DHTSensor.hpp"
 #include "Primus/Database/DHTSensorList.hpp"
 #include "Primus/Database/Queries/DHT.h"
@@ -54,7 +55,7 @@ Database::DHTSensorList::TotalNumber()
     return numberOfSensors;
 }
 
-Database::DHTSensor&
+Database::DHTSensor
 Database::DHTSensorList::SensorByIndex(const unsigned long thermaIndex)
 {
     unsigned long sensorId;
@@ -95,113 +96,35 @@ Database::DHTSensorList::SensorByIndex(const unsigned long thermaIndex)
     return Database::DHTSensorList::SensorById(sensorId);
 }
 
-Database::DHTSensor&
+Database::DHTSensor
 Database::DHTSensorList::SensorById(const unsigned long sensorId)
 {
-    Database::DHTSensor* sensor = new Database::DHTSensor(sensorId);
-
-    return *sensor;
+    return Database::DHTSensor(sensorId);
 }
 
-void
-Database::NoticeDHTSensorHumidity(
-    Toolkit::Timestamp& originTimestamp,
-    const std::string&  sensorToken,
-    const double        stampAsReal,
-    const float         humidity)
+/**
+ * @brief   Load all DHT11/DHT22 sensors with one query, in the order they are listed.
+ */
+Database::EntityList<Database::DHTSensor>
+Database::DHTSensorList::AllSensors()
 {
-    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Sensors);
-
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { database.lock };
+    Database::EntityList<Database::DHTSensor> sensors;
 
-        PostgreSQL::Transaction transaction(database.connection());
-
-        {
-            PostgreSQL::Query query(database.connection());
-
-            union
-            {
-                unsigned long   stampInteger;
-                double          stampReal;
-            };
-
-            memcpy(&stampInteger, &stampAsReal, sizeof(stampAsReal));
-            stampInteger = htobe64(stampInteger);
-
-            union
-            {
-                unsigned int    humidityInteger;
-                float           humidityReal;
-            };
-
-            memcpy(&humidityInteger, &humidity, sizeof(humidity));
-            humidityInteger = htobe32(humidityInteger);
-
-            query.pushTIMESTAMP(originTimestamp);
-            query.pushUUID(&sensorToken);
-            query.pushDOUBLE(&stampReal);
-            query.pushREAL(&humidityReal);
-            query.execute(QueryInsertDHTSensorHumidity);
-        }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
-    {
-        database.recover(exception);
-
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportError("[Database] Cannot store DHT11/DHT22 sensor humidity: %s",
-                exception.what());
-
-        throw exception;
-    }
-}
-
-void
-Database::NoticeDHTSensorTemperature(
-    Toolkit::Timestamp& originTimestamp,
-    const std::string&  sensorToken,
-    const double        stampAsReal,
-    const float         temperature)
-{
     Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Sensors);
 
     try
     {
         std::unique_lock<std::mutex> queueLock { database.lock };
 
-        PostgreSQL::Transaction transaction(database.connection());
+        PostgreSQL::Query query(database.connection());
 
+        query.execute(QueryAllDHTSensors);
+
+        while (query.reachedLastRow() == false)
         {
-            PostgreSQL::Query query(database.connection());
-
-            union
-            {
-                unsigned long   stampInteger;
-                double          stampReal;
-            };
-
-            memcpy(&stampInteger, &stampAsReal, sizeof(stampAsReal));
-            stampInteger = htobe64(stampInteger);
-
-            union
-            {
-                unsigned int    temperatureInteger;
-                float           temperatureReal;
-            };
-
-            memcpy(&temperatureInteger, &temperature, sizeof(temperature));
-            temperatureInteger = htobe32(temperatureInteger);
-
-            query.pushTIMESTAMP(originTimestamp);
-            query.pushUUID(&sensorToken);
-            query.pushDOUBLE(&stampReal);
-            query.pushREAL(&temperatureReal);
-            query.execute(QueryInsertDHTSensorTemperature);
+            sensors.emplace_back(query);
+
+            query.nextRow();
         }
     }
     catch (PostgreSQL::OperatorIntervention& exception)
@@ -212,9 +135,11 @@ Database::NoticeDHTSensorTemperature(
     }
     catch (PostgreSQL::Exception& exception)
     {
-        ReportError("[Database] Cannot store DHT11/DHT22 sensor temperature: %s",
+        ReportError("[Database] Cannot load list of DHT11/DHT22 sensors: %s",
                 exception.what());
 
         throw exception;
     }
+
+    return sensors;
 }
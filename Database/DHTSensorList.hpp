@@ -11,6 +11,7 @@
 
 // Local definition files.
 //
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/DHTSensor.hpp"
 
 namespace Database
@@ -21,24 +22,13 @@ namespace Database
         static unsigned long
         TotalNumber();
 
-        static Database::DHTSensor&
+        static Database::DHTSensor
         SensorByIndex(const unsigned long);
 
-        static Database::DHTSensor&
+        static Database::DHTSensor
         SensorById(const unsigned long);
-    };
-
-    void
-    NoticeDHTSensorHumidity(
-        Toolkit::Timestamp& originTimestamp,
-        const std::string&  sensorToken,
-        const double        stampAsReal,
-        const float         humidity);
 
-    void
-    NoticeDHTSensorTemperature(
-        Toolkit::Timestamp& originTimestamp,
-        const std::string&  sensorToken,
-        const double        stampAsReal,
-        const float         temperature);
+        static Database::EntityList<Database::DHTSensor>
+        AllSensors();
+    };
 };
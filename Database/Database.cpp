@@ -1,5 +1,6 @@
 // System definition files.
 //
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <system_error>
@@ -8,6 +9,7 @@
 //
 #include "PostgreSQL/Exception.hpp"
 #include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Times.hpp"
 
 // Local definition files.
 //
@@ -72,3 +74,22 @@ Primus::Database::recover(PostgreSQL::OperatorIntervention& exception)
         this->connect();
     }
 }
+
+/**
+ * @brief   Pop a timestamp column and keep it by value.
+ *
+ * PostgreSQL library hands timestamps over as allocated objects,
+ * which are released here right away.
+ *
+ * @return  Timestamp of column, or current time in case column is null.
+ */
+Toolkit::Timestamp
+Primus::PopTimestamp(PostgreSQL::Query& query)
+{
+    std::unique_ptr<Toolkit::Timestamp> timestamp { query.popTIMESTAMP() };
+
+    if (timestamp == nullptr)
+        return Toolkit::Timestamp();
+
+    return *timestamp;
+}
@@ -8,6 +8,7 @@
 //
 #include "PostgreSQL/Exception.hpp"
 #include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Times.hpp"
 
 namespace Primus
 {
@@ -50,4 +51,7 @@ namespace Primus
         connection()
         { return *this->connectionInstance; }
     };
+
+    Toolkit::Timestamp
+    PopTimestamp(PostgreSQL::Query& query);
 };
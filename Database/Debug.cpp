@@ -1,10 +1,18 @@
 // System definition files.
 //
 #include <endian.h>
+#include <algorithm>
+#include <cstdio>
+#include <chrono>
 #include <cstring>
+#include <iterator>
 #include <mutex>
 #include <stdexcept>
+#include <string>
 #include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
 // Common definition files.
 //
@@ -21,6 +29,17 @@
 
 static Primus::Debug* instance = NULL;
 
+static void
+ExecuteEntry(
+    PostgreSQL::Connection& connection,
+    Primus::DebugEntry&     entry);
+
+static void
+ExecuteRTSPRows(
+    PostgreSQL::Connection& connection,
+    Primus::DebugEntry*     first,
+    Primus::DebugEntry*     last);
+
 Primus::Debug&
 Primus::Debug::InitInstance()
 {
@@ -43,6 +62,11 @@ Primus::Debug::SharedInstance()
 
 Primus::Debug::Debug()
 {
+    this->lastSessionId = 0;
+
+    this->queue.written = 0;
+    this->queue.dropped = 0;
+
     this->connect();
 }
 
@@ -78,141 +102,370 @@ Primus::Debug::recover(PostgreSQL::OperatorIntervention& exception)
     }
 }
 
+void
+Primus::Debug::startService()
+{
+    this->thread = std::thread(&Primus::Debug::ThreadHandler, this);
+}
+
+Primus::DebugStatistics
+Primus::Debug::statistics()
+{
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+    return { this->queue.written, this->queue.dropped, this->queue.entries.size() };
+}
+
 unsigned long
 Primus::Debug::BeginServusSession(const std::string& servusIP)
 {
     Primus::Debug& debug = Primus::Debug::SharedInstance();
 
-    unsigned long sessionId = 0;
+    return debug.beginSession(Primus::DebugBeginServusSession, servusIP);
+}
 
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+void
+Primus::Debug::CloseServusSession(const unsigned long sessionId)
+{
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
 
-        PostgreSQL::Transaction transaction(debug.connection());
+    Primus::DebugEntry entry { Primus::DebugCloseServusSession, sessionId, "", "", 0 };
 
-        {
-            PostgreSQL::Query query(debug.connection());
+    debug.enqueue(entry);
+}
 
-            query.pushINET(servusIP.c_str(), servusIP.length());
+void
+Primus::Debug::CommentServusSession(
+    const unsigned long sessionId,
+    const std::string&  comment)
+{
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
 
-            query.execute(QueryBeginServusSession);
+    Primus::DebugEntry entry { Primus::DebugCommentServusSession, sessionId, comment, "", 0 };
 
-            query.assertNumberOfRows(1);
-            query.assertNumberOfColumns(1);
-            query.assertColumnOfType(0, PostgreSQL::INT8OID);
+    debug.enqueue(entry);
+}
 
-            sessionId = query.popBIGINT();
-        }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
-    {
-        debug.recover(exception);
+void
+Primus::Debug::ReportServusRTSP(
+    const unsigned long sessionId,
+    const std::string&  request,
+    const std::string&  response)
+{
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
 
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
-    }
+    Primus::DebugEntry entry { Primus::DebugServusRTSP, sessionId, request, response, 0 };
 
-    return sessionId;
+    debug.enqueue(entry);
+}
+
+unsigned long
+Primus::Debug::BeginPhoenixSession(const std::string& phoenixIP)
+{
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
+
+    return debug.beginSession(Primus::DebugBeginPhoenixSession, phoenixIP);
 }
 
 void
-Primus::Debug::CloseServusSession(const unsigned long sessionId)
+Primus::Debug::ClosePhoenixSession(const unsigned long sessionId)
 {
     Primus::Debug& debug = Primus::Debug::SharedInstance();
 
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+    Primus::DebugEntry entry { Primus::DebugClosePhoenixSession, sessionId, "", "", 0 };
 
-        PostgreSQL::Transaction transaction(debug.connection());
+    debug.enqueue(entry);
+}
 
-        {
-            PostgreSQL::Query query(debug.connection());
+void
+Primus::Debug::CommentPhoenixSession(
+    const unsigned long sessionId,
+    const std::string&  comment)
+{
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
 
-            unsigned long sessionIdQuery = htobe64(sessionId);
+    Primus::DebugEntry entry { Primus::DebugCommentPhoenixSession, sessionId, comment, "", 0 };
 
-            query.pushBIGINT(&sessionIdQuery);
+    debug.enqueue(entry);
+}
+
+void
+Primus::Debug::ReportPhoenixRTSP(
+    const unsigned long sessionId,
+    RTSP::Datagram&     request,
+    RTSP::Datagram&     response)
+{
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
+
+    Primus::DebugEntry entry
+    {
+        Primus::DebugPhoenixRTSP,
+        sessionId,
+        std::string(request.contentBuffer, request.contentLength),
+        std::string(response.contentBuffer, response.contentLength),
+        response.statusCode
+    };
+
+    debug.enqueue(entry);
+}
+
+/**
+ * @brief   Put an event into the queue of writer thread.
+ *
+ * Never blocks - if the queue is full, the event is dropped and counted.
+ * Events without session are dropped silently.
+ *
+ * @param   entry           Event to be written. Entry is emptied.
+ *
+ * @return  True if event has been queued, false if it has been dropped.
+ */
+bool
+Primus::Debug::enqueue(Primus::DebugEntry& entry)
+{
+    if (entry.sessionId == 0)
+        return false;
+
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
 
-            query.execute(QueryCloseServusSession);
+    if (this->queue.entries.size() >= Primus::DebugQueueCapacity)
+    {
+        // Report only every now and then to not flood the log while database is stuck.
+        //
+        if (this->queue.dropped++ % 1000 == 0)
+        {
+            ReportWarning("[Debug] Queue is full, %lu entries dropped so far",
+                    this->queue.dropped);
         }
+
+        return false;
     }
-    catch (PostgreSQL::OperatorIntervention& exception)
+
+    this->queue.entries.push_back(std::move(entry));
+
+    this->queue.condition.notify_one();
+
+    return true;
+}
+
+/**
+ * @brief   Open debug session.
+ *
+ * Session id is generated locally, so that no database access is necessary
+ * to accept a connection. Session row is written by the writer thread
+ * before any other event of the session.
+ *
+ * @param   kind            Whether a servus or a phoenix session is opened.
+ * @param   peerIP          IP address of peer.
+ *
+ * @return  Session id.
+ */
+unsigned long
+Primus::Debug::beginSession(
+    const Primus::DebugEntryKind    kind,
+    const std::string&              peerIP)
+{
+    const unsigned long sessionId = this->nextSessionId();
+
+    Primus::DebugEntry entry { kind, sessionId, peerIP, "", 0 };
+
+    this->enqueue(entry);
+
+    return sessionId;
+}
+
+/**
+ * @brief   Generate a new session id.
+ *
+ * Ids are strictly increasing and ordered by time of session begin.
+ * Counter part lets more sessions begin within the same millisecond.
+ *
+ * @return  Session id.
+ */
+unsigned long
+Primus::Debug::nextSessionId()
+{
+    const unsigned long milliseconds =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+
+    const unsigned long earliestSessionId = milliseconds << Primus::DebugSessionIdCounterBits;
+
+    unsigned long lastSessionId = this->lastSessionId.load();
+    unsigned long sessionId;
+
+    do
     {
-        debug.recover(exception);
+        sessionId = std::max(lastSessionId + 1, earliestSessionId);
+    }
+    while (this->lastSessionId.compare_exchange_weak(lastSessionId, sessionId) == false);
+
+    return sessionId;
+}
+
+/**
+ * @brief   Wait for events and take the next batch out of the queue.
+ *
+ * @param   batch           Vector to be filled with events.
+ */
+void
+Primus::Debug::collectBatch(std::vector<Primus::DebugEntry>& batch)
+{
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
 
-        throw exception;
+    while (this->queue.entries.empty() == true)
+    {
+        this->queue.condition.wait(queueLock);
     }
-    catch (PostgreSQL::Exception& exception)
+
+    while ((this->queue.entries.empty() == false) &&
+           (batch.size() < Primus::DebugBatchSize))
     {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
+        batch.push_back(std::move(this->queue.entries.front()));
+
+        this->queue.entries.pop_front();
     }
 }
 
+/**
+ * @brief   Write a batch of events within one transaction.
+ *
+ * Consecutive request/response pairs are stored with one multi-row insert.
+ * If the batch is rejected, for example because of bad characters in a request
+ * or because the session it belongs to has been dropped, events are written
+ * one by one, so that a single bad event does not cost the whole batch.
+ * If database is not available, events not written yet are put back into the queue,
+ * so that session rows are not lost together with everything referring to them.
+ *
+ * @param   batch           Events to be written.
+ */
 void
-Primus::Debug::CommentServusSession(
-    const unsigned long sessionId,
-    const std::string&  comment)
+Primus::Debug::writeBatch(std::vector<Primus::DebugEntry>& batch)
 {
-    Primus::Debug& debug = Primus::Debug::SharedInstance();
+    bool batchWritten = false;
+    bool batchRejected = false;
 
     try
     {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+        std::unique_lock<std::mutex> queueLock { this->lock };
 
-        PostgreSQL::Transaction transaction(debug.connection());
+        PostgreSQL::Transaction transaction(this->connection());
 
+        Primus::DebugEntry* entry = batch.data();
+        Primus::DebugEntry* const end = batch.data() + batch.size();
+
+        while (entry != end)
         {
-            PostgreSQL::Query query(debug.connection());
+            if ((entry->kind == Primus::DebugServusRTSP) || (entry->kind == Primus::DebugPhoenixRTSP))
+            {
+                Primus::DebugEntry* last = entry;
 
-            unsigned long sessionIdQuery = htobe64(sessionId);
+                while ((last != end) && (last->kind == entry->kind))
+                    last++;
 
-            query.pushBIGINT(&sessionIdQuery);
-            query.pushVARCHAR(&comment);
+                ExecuteRTSPRows(this->connection(), entry, last);
 
-            query.execute(QueryCommentServusSession);
+                entry = last;
+            }
+            else
+            {
+                ExecuteEntry(this->connection(), *entry);
+
+                entry++;
+            }
         }
+
+        batchWritten = true;
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
-        debug.recover(exception);
+        this->recover(exception);
 
-        throw exception;
+        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
     }
-    catch (PostgreSQL::Exception& exception)
+    catch (PostgreSQL::Exception&)
     {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
+        batchRejected = true;
+    }
+
+    if (batchWritten == true)
+    {
+        std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+        this->queue.written += batch.size();
+    }
+    else if (batchRejected == true)
+    {
+        for (auto entry = batch.begin(); entry != batch.end(); entry++)
+        {
+            if (this->writeEntry(*entry) == false)
+            {
+                this->requeueBatch(batch, entry);
+
+                break;
+            }
+        }
+    }
+    else
+    {
+        this->requeueBatch(batch, batch.begin());
     }
 }
 
+/**
+ * @brief   Put events back to the head of the queue and pause writer.
+ *
+ * Events keep their order. Queue may exceed its capacity by this batch,
+ * newer events are dropped meanwhile.
+ *
+ * @param   batch           Events taken out of the queue.
+ * @param   first           First event not written yet.
+ */
 void
-Primus::Debug::ReportServusRTSP(
-    const unsigned long sessionId,
-    RTSP::Datagram&     request,
-    RTSP::Datagram&     response)
+Primus::Debug::requeueBatch(
+    std::vector<Primus::DebugEntry>&            batch,
+    std::vector<Primus::DebugEntry>::iterator   first)
 {
-    Primus::Debug& debug = Primus::Debug::SharedInstance();
-
-    try
     {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+        std::unique_lock<std::mutex> queueLock { this->queue.lock };
 
-        PostgreSQL::Transaction transaction(debug.connection());
+        this->queue.entries.insert(
+                this->queue.entries.begin(),
+                std::make_move_iterator(first),
+                std::make_move_iterator(batch.end()));
+    }
 
-        {
-            PostgreSQL::Query query(debug.connection());
+    std::this_thread::sleep_for(
+            std::chrono::milliseconds { Primus::DebugRetryInterval });
+}
 
-            unsigned long sessionIdQuery = htobe64(sessionId);
+/**
+ * @brief   Write a single event within its own transaction.
+ *
+ * @param   entry           Event to be written.
+ *
+ * @return  False if database is not available and event has been neither written nor dropped.
+ */
+bool
+Primus::Debug::writeEntry(Primus::DebugEntry& entry)
+{
+    bool entryWritten = false;
 
-            query.pushBIGINT(&sessionIdQuery);
-            query.pushVARCHAR(request.contentBuffer, request.contentLength);
-            query.pushVARCHAR(response.contentBuffer, response.contentLength);
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { this->lock };
 
-            query.execute(QueryReportServusRTSP);
+        PostgreSQL::Transaction transaction(this->connection());
+
+        if ((entry.kind == Primus::DebugServusRTSP) || (entry.kind == Primus::DebugPhoenixRTSP))
+        {
+            ExecuteRTSPRows(this->connection(), &entry, &entry + 1);
+        }
+        else
+        {
+            ExecuteEntry(this->connection(), entry);
         }
+
+        entryWritten = true;
     }
     catch (PostgreSQL::DataException& exception)
     {
@@ -227,162 +480,185 @@ Primus::Debug::ReportServusRTSP(
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
-        debug.recover(exception);
+        this->recover(exception);
+
+        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
 
-        throw exception;
+        return false;
     }
     catch (PostgreSQL::Exception& exception)
     {
         ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
     }
-}
 
-unsigned long
-Primus::Debug::BeginPhoenixSession(const std::string& phoenixIP)
-{
-    Primus::Debug& debug = Primus::Debug::SharedInstance();
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
 
-    unsigned long sessionId = 0;
-
-    try
+    if (entryWritten == true)
     {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
-
-        PostgreSQL::Transaction transaction(debug.connection());
-
-        {
-            PostgreSQL::Query query(debug.connection());
+        this->queue.written++;
+    }
+    else
+    {
+        this->queue.dropped++;
+    }
 
-            query.pushINET(phoenixIP.c_str(), phoenixIP.length());
+    return true;
+}
 
-            query.execute(QueryBeginPhoenixSession);
+/**
+ * @brief   Thread handler for debug writer.
+ */
+void
+Primus::Debug::ThreadHandler(Primus::Debug* debug)
+{
+    ReportNotice("[Debug] Writer thread has been started");
 
-            query.assertNumberOfRows(1);
-            query.assertNumberOfColumns(1);
-            query.assertColumnOfType(0, PostgreSQL::INT8OID);
+    std::vector<Primus::DebugEntry> batch;
+    batch.reserve(Primus::DebugBatchSize);
 
-            sessionId = query.popBIGINT();
-        }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
+    for (;;)
     {
-        debug.recover(exception);
+        debug->collectBatch(batch);
 
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
+        debug->writeBatch(batch);
+
+        batch.clear();
     }
 
-    return sessionId;
+    ReportWarning("[Debug] Writer thread is going to quit");
 }
 
-void
-Primus::Debug::ClosePhoenixSession(const unsigned long sessionId)
+/**
+ * @brief   Execute query of a session event.
+ *
+ * @param   connection      Database connection with open transaction.
+ * @param   entry           Event to be written.
+ */
+static void
+ExecuteEntry(
+    PostgreSQL::Connection& connection,
+    Primus::DebugEntry&     entry)
 {
-    Primus::Debug& debug = Primus::Debug::SharedInstance();
+    PostgreSQL::Query query(connection);
 
-    try
+    unsigned long sessionIdQuery = htobe64(entry.sessionId);
+
+    switch (entry.kind)
     {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+        case Primus::DebugBeginServusSession:
+        case Primus::DebugBeginPhoenixSession:
+        {
+            query.pushBIGINT(&sessionIdQuery);
+            query.pushINET(entry.text.c_str(), entry.text.length());
 
-        PostgreSQL::Transaction transaction(debug.connection());
+            query.execute((entry.kind == Primus::DebugBeginServusSession)
+                    ? QueryBeginServusSession
+                    : QueryBeginPhoenixSession);
+            break;
+        }
 
+        case Primus::DebugCloseServusSession:
+        case Primus::DebugClosePhoenixSession:
         {
-            PostgreSQL::Query query(debug.connection());
+            query.pushBIGINT(&sessionIdQuery);
 
-            unsigned long sessionIdQuery = htobe64(sessionId);
+            query.execute((entry.kind == Primus::DebugCloseServusSession)
+                    ? QueryCloseServusSession
+                    : QueryClosePhoenixSession);
+            break;
+        }
 
+        case Primus::DebugCommentServusSession:
+        case Primus::DebugCommentPhoenixSession:
+        {
             query.pushBIGINT(&sessionIdQuery);
+            query.pushVARCHAR(&entry.text);
 
-            query.execute(QueryClosePhoenixSession);
+            query.execute((entry.kind == Primus::DebugCommentServusSession)
+                    ? QueryCommentServusSession
+                    : QueryCommentPhoenixSession);
+            break;
         }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
-    {
-        debug.recover(exception);
 
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
+        default:
+            break;
     }
 }
 
-void
-Primus::Debug::CommentPhoenixSession(
-    const unsigned long sessionId,
-    const std::string&  comment)
+/**
+ * @brief   Store request/response pairs of the same kind with one multi-row insert.
+ *
+ * @param   connection      Database connection with open transaction.
+ * @param   first           First pair to be stored.
+ * @param   last            End of range of pairs to be stored.
+ */
+static void
+ExecuteRTSPRows(
+    PostgreSQL::Connection& connection,
+    Primus::DebugEntry*     first,
+    Primus::DebugEntry*     last)
 {
-    Primus::Debug& debug = Primus::Debug::SharedInstance();
+    const bool servus = (first->kind == Primus::DebugServusRTSP);
 
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+    // Query keeps pointers to pushed values until it is executed.
+    //
+    std::vector<unsigned long> sessionIds;
+    std::vector<unsigned int> responseStatuses;
 
-        PostgreSQL::Transaction transaction(debug.connection());
+    sessionIds.reserve(last - first);
+    responseStatuses.reserve(last - first);
 
-        {
-            PostgreSQL::Query query(debug.connection());
+    std::string queryText = (servus == true)
+            ? QueryReportServusRTSPHead
+            : QueryReportPhoenixRTSPHead;
 
-            unsigned long sessionIdQuery = htobe64(sessionId);
+    PostgreSQL::Query query(connection);
 
-            query.pushBIGINT(&sessionIdQuery);
-            query.pushVARCHAR(&comment);
+    unsigned int parameterNumber = 1;
 
-            query.execute(QueryCommentPhoenixSession);
-        }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
+    for (Primus::DebugEntry* entry = first; entry != last; entry++)
     {
-        debug.recover(exception);
+        sessionIds.push_back(htobe64(entry->sessionId));
+        responseStatuses.push_back(htobe32(entry->responseStatus));
 
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
-    }
-}
+        char row[60];
 
-void
-Primus::Debug::ReportPhoenixRTSP(
-    const unsigned long sessionId,
-    RTSP::Datagram&     request,
-    RTSP::Datagram&     response)
-{
-    Primus::Debug& debug = Primus::Debug::SharedInstance();
+        if (servus == true)
+        {
+            snprintf(row, sizeof(row),
+                    QueryReportServusRTSPRow,
+                    parameterNumber,
+                    parameterNumber + 1,
+                    parameterNumber + 2);
+        }
+        else
+        {
+            snprintf(row, sizeof(row),
+                    QueryReportPhoenixRTSPRow,
+                    parameterNumber,
+                    parameterNumber + 1,
+                    parameterNumber + 2,
+                    parameterNumber + 3);
+        }
 
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { debug.lock };
+        if (parameterNumber > 1)
+            queryText += ", ";
 
-        PostgreSQL::Transaction transaction(debug.connection());
+        queryText += row;
 
-        {
-            PostgreSQL::Query query(debug.connection());
+        query.pushBIGINT(&sessionIds.back());
+        query.pushVARCHAR(entry->text.data(), entry->text.length());
+        query.pushVARCHAR(entry->response.data(), entry->response.length());
 
-            unsigned long sessionIdQuery = htobe64(sessionId);
-            unsigned int responseStatus = htobe32(response.statusCode);
+        parameterNumber += 3;
 
-            query.pushBIGINT(&sessionIdQuery);
-            query.pushVARCHAR(request.contentBuffer, request.contentLength);
-            query.pushVARCHAR(response.contentBuffer, response.contentLength);
-            query.pushINTEGER(&responseStatus);
+        if (servus == false)
+        {
+            query.pushINTEGER(&responseStatuses.back());
 
-            query.execute(QueryReportPhoenixRTSP);
+            parameterNumber++;
         }
     }
-    catch (PostgreSQL::OperatorIntervention& exception)
-    {
-        debug.recover(exception);
 
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportWarning("[Debug] PostgreSQL exception: %s", exception.what());
-    }
+    query.execute(queryText.c_str());
 }
@@ -2,8 +2,13 @@
 
 // System definition files.
 //
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 // Common definition files.
 //
@@ -13,11 +18,76 @@
 
 namespace Primus
 {
+    static const unsigned int DebugQueueCapacity    = 10000;    /**< Entries. */
+    static const unsigned int DebugBatchSize        = 200;      /**< Entries. */
+    static const unsigned int DebugRetryInterval    = 5000;     /**< Milliseconds. */
+
+    /**
+     * Session ids are composed of milliseconds since Unix epoch shifted by this
+     * number of bits and a counter, so that they grow across restarts of Primus.
+     */
+    static const unsigned int DebugSessionIdCounterBits = 20;
+
+    enum DebugEntryKind
+    {
+        DebugBeginServusSession,
+        DebugCloseServusSession,
+        DebugCommentServusSession,
+        DebugServusRTSP,
+        DebugBeginPhoenixSession,
+        DebugClosePhoenixSession,
+        DebugCommentPhoenixSession,
+        DebugPhoenixRTSP
+    };
+
+    /**
+     * Debug event waiting to be written to database.
+     */
+    struct DebugEntry
+    {
+        Primus::DebugEntryKind          kind;
+        unsigned long                   sessionId;
+        std::string                     text;               /**< IP address, comment or request. */
+        std::string                     response;
+        unsigned int                    responseStatus;
+    };
+
+    struct DebugStatistics
+    {
+        unsigned long   written;            /**< Entries written to database. */
+        unsigned long   dropped;            /**< Entries dropped because queue was full or database refused them. */
+        unsigned long   queued;             /**< Entries currently waiting in queue. */
+    };
+
+    /**
+     * Debug capture. Events are put into a bounded queue and written
+     * in batches by a background writer, so that sessions never wait for database.
+     */
     class Debug
     {
     private:
         PostgreSQL::Connection* connectionInstance;
 
+        /**
+         * Last session id handed out.
+         */
+        std::atomic<unsigned long> lastSessionId;
+
+        /**
+         * Thread handler of writer thread.
+         */
+        std::thread thread;
+
+        struct
+        {
+            std::mutex                      lock;
+            std::condition_variable         condition;
+            std::deque<Primus::DebugEntry>  entries;
+            unsigned long                   written;
+            unsigned long                   dropped;
+        }
+        queue;
+
     public:
         std::mutex lock;
 
@@ -41,6 +111,12 @@ namespace Primus
         connection()
         { return *this->connectionInstance; }
 
+        void
+        startService();
+
+        Primus::DebugStatistics
+        statistics();
+
         static unsigned long
         BeginServusSession(const std::string& servusIP);
 
@@ -55,8 +131,8 @@ namespace Primus
         static void
         ReportServusRTSP(
             const unsigned long sessionId,
-            RTSP::Datagram&     request,
-            RTSP::Datagram&     response);
+            const std::string&  request,
+            const std::string&  response);
 
         static unsigned long
         BeginPhoenixSession(const std::string& phoenixIP);
@@ -74,5 +150,34 @@ namespace Primus
             const unsigned long sessionId,
             RTSP::Datagram&     request,
             RTSP::Datagram&     response);
+
+    private:
+        bool
+        enqueue(Primus::DebugEntry& entry);
+
+        unsigned long
+        beginSession(
+            const Primus::DebugEntryKind    kind,
+            const std::string&              peerIP);
+
+        unsigned long
+        nextSessionId();
+
+        void
+        collectBatch(std::vector<Primus::DebugEntry>& batch);
+
+        void
+        writeBatch(std::vector<Primus::DebugEntry>& batch);
+
+        bool
+        writeEntry(Primus::DebugEntry& entry);
+
+        void
+        requeueBatch(
+            std::vector<Primus::DebugEntry>&            batch,
+            std::vector<Primus::DebugEntry>::iterator   first);
+
+        static void
+        ThreadHandler(Primus::Debug*);
     };
 };
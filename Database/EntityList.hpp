@@ -0,0 +1,15 @@
+#pragma once
+
+// System definition files.
+//
+#include <vector>
+
+namespace Database
+{
+    /**
+     * Entities loaded at once for a list. Entities are owned by the list
+     * and released together with it.
+     */
+    template<typename Entity>
+    using EntityList = std::vector<Entity>;
+};
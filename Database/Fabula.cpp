@@ -10,6 +10,7 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
 #include "Primus/Database/Database.hpp"
 #include "Primus/Database/Fabula.hpp"
 #include "Primus/Database/Queries/Fabula.h"
@@ -30,22 +31,8 @@ Database::Fabula::Fabula(const unsigned long fabulaId)
         query.execute(QuerySearchForFabulaById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(7);
-        query.assertColumnOfType(0, PostgreSQL::INT8OID);
-        query.assertColumnOfType(1, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(2, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(3, PostgreSQL::INT8OID);
-        query.assertColumnOfType(4, PostgreSQL::VARCHAROID);
-        query.assertColumnOfType(5, PostgreSQL::INT2OID);
-        query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
-
-        this->fabulaId          = query.popBIGINT();
-        this->fabulaToken       = query.popUUID();
-        this->originTimestamp   = query.popTIMESTAMP();
-        this->servusId          = query.popBIGINT();
-        this->originatorLabel   = query.popVARCHAR();
-        this->severityLevel     = query.popSMALL();
-        this->message           = query.popVARCHAR();
+
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -62,12 +49,36 @@ Database::Fabula::Fabula(const unsigned long fabulaId)
     }
 }
 
-Database::Fabula::~Fabula()
+/**
+ * @brief   Load fabula from current row of a query selecting the same columns as by id.
+ */
+Database::Fabula::Fabula(PostgreSQL::Query& query)
+{
+    this->loadRow(query);
+}
+
+void
+Database::Fabula::loadRow(PostgreSQL::Query& query)
 {
-    if (this->originTimestamp != nullptr)
-        delete this->originTimestamp;
+    query.assertNumberOfColumns(7);
+    query.assertColumnOfType(0, PostgreSQL::INT8OID);
+    query.assertColumnOfType(1, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(2, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(3, PostgreSQL::INT8OID);
+    query.assertColumnOfType(4, PostgreSQL::VARCHAROID);
+    query.assertColumnOfType(5, PostgreSQL::INT2OID);
+    query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
+
+    this->fabulaId          = query.popBIGINT();
+    this->fabulaToken       = Primus::UUID::FromString(query.popUUID());
+    this->originTimestamp   = Primus::PopTimestamp(query);
+    this->servusId          = query.popBIGINT();
+    this->originatorLabel   = query.popVARCHAR();
+    this->severityLevel     = query.popSMALL();
+    this->message           = query.popVARCHAR();
 }
-std::string
+
+Primus::UUID
 Database::Fabula::Enqueue(
     Toolkit::Timestamp&     originTimestamp,
     const unsigned long     servusId,
@@ -100,9 +111,7 @@ Database::Fabula::Enqueue(
             query.assertNumberOfColumns(1);
             query.assertColumnOfType(0, PostgreSQL::UUIDOID);
 
-            const std::string fabulaToken = query.popUUID();
-
-            return fabulaToken;
+            return Primus::UUID::FromString(query.popUUID());
         }
     }
     catch (PostgreSQL::OperatorIntervention& exception)
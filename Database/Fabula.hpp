@@ -6,16 +6,21 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class Fabula
     {
     public:
         unsigned long       fabulaId;
-        std::string         fabulaToken;
-        Toolkit::Timestamp* originTimestamp;
+        Primus::UUID        fabulaToken;
+        Toolkit::Timestamp  originTimestamp;
         unsigned long       servusId;
         std::string         originatorLabel;
         unsigned short      severityLevel;
@@ -24,14 +29,18 @@ namespace Database
     public:
         Fabula(const unsigned long fabulaId);
 
-        ~Fabula();
+        Fabula(PostgreSQL::Query& query);
 
-        static std::string
+        static Primus::UUID
         Enqueue(
             Toolkit::Timestamp&     originTimestamp,
             const unsigned long     servusId,
             const std::string&      originatorLabel,
             const unsigned short    severityLevel,
             const std::string&      message);
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
@@ -11,6 +11,7 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
 #include "Primus/Database/Database.hpp"
 #include "Primus/Database/Fabula.hpp"
 #include "Primus/Database/Fabulas.hpp"
@@ -54,7 +55,7 @@ Database::Fabulas::totalNumber()
     return numberOfFabulas;
 }
 
-Database::Fabula&
+Database::Fabula
 Database::Fabulas::fabulaByIndex(const unsigned long fabulaIndex)
 {
     unsigned long fabulaId;
@@ -95,17 +96,15 @@ Database::Fabulas::fabulaByIndex(const unsigned long fabulaIndex)
     return this->fabulaById(fabulaId);
 }
 
-Database::Fabula&
+Database::Fabula
 Database::Fabulas::fabulaById(const unsigned long fabulaId)
 {
-    Database::Fabula* fabula = new Database::Fabula(fabulaId);
-
-    return *fabula;
+    return Database::Fabula(fabulaId);
 }
 
 const std::string
 Database::Fabulas::FabulasAsXML(
-    const std::string&  lastKnownFabulaToken,
+    const Primus::UUID& lastKnownFabulaToken,
     const unsigned int  maximalFabulasPerXML)
 {
     Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
@@ -118,7 +117,9 @@ Database::Fabulas::FabulasAsXML(
 
         unsigned int limitQuery = htobe32(maximalFabulasPerXML);
 
-        if (lastKnownFabulaToken.empty() == true)
+        const std::string lastKnownFabulaTokenQuery = lastKnownFabulaToken.asString();
+
+        if (lastKnownFabulaToken.isNil() == true)
         {
             // Set second argument tu null in case fabula token has not been specified.
             //
@@ -126,7 +127,7 @@ Database::Fabulas::FabulasAsXML(
         }
         else
         {
-            query.pushUUID(&lastKnownFabulaToken);
+            query.pushUUID(&lastKnownFabulaTokenQuery);
         }
         query.pushINTEGER(&limitQuery);
         query.execute(QueryFabulasAsXML);
@@ -2,6 +2,7 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
 #include "Primus/Database/Fabula.hpp"
 
 namespace Database
@@ -12,15 +13,15 @@ namespace Database
         unsigned long
         totalNumber();
 
-        Database::Fabula&
+        Database::Fabula
         fabulaByIndex(const unsigned long);
 
-        Database::Fabula&
+        Database::Fabula
         fabulaById(const unsigned long);
 
         static const std::string
         FabulasAsXML(
-            const std::string&  lastKnownFabulaToken,
+            const Primus::UUID& lastKnownFabulaToken,
             const unsigned int  maximalFabulasPerXML);
     };
 };
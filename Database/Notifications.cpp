@@ -0,0 +1,305 @@
+// System definition files.
+//
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// PostgreSQL definition files.
+//
+#include <libpq-fe.h>
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Database/Notifications.hpp"
+
+static Database::Notifications* instance = NULL;
+
+Database::Notifications&
+Database::Notifications::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[Notifications] Already initialized");
+
+    instance = new Database::Notifications();
+
+    return *instance;
+}
+
+Database::Notifications&
+Database::Notifications::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[Notifications] Not initialized");
+
+    return *instance;
+}
+
+Database::Notifications::Notifications()
+{
+    this->wakeupDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (this->wakeupDescriptor < 0)
+        throw std::runtime_error("[Notifications] Cannot create wakeup descriptor");
+}
+
+void
+Database::Notifications::startService()
+{
+    this->thread = std::thread(&Database::Notifications::ThreadHandler, this);
+}
+
+/**
+ * @brief   Register handler to be called whenever a channel is notified.
+ *
+ * Handlers are called from listener thread and should return quickly.
+ *
+ * @param   channel         Name of PostgreSQL notification channel.
+ * @param   handler         Handler to be called.
+ */
+void
+Database::Notifications::subscribe(
+    const std::string&              channel,
+    Database::NotificationHandler   handler)
+{
+    std::unique_lock<std::mutex> subscriptionsLock { this->subscriptions.lock };
+
+    this->subscriptions.handlers[channel].push_back(handler);
+}
+
+/**
+ * @brief   Have handlers of a channel called by listener thread, as if it had been notified.
+ *
+ * Returns immediately, so that callers in the request path never wait for
+ * what handlers load from database.
+ *
+ * @param   channel         Name of PostgreSQL notification channel.
+ */
+void
+Database::Notifications::trigger(const std::string& channel)
+{
+    {
+        std::unique_lock<std::mutex> subscriptionsLock { this->subscriptions.lock };
+
+        this->subscriptions.triggered.insert(channel);
+    }
+
+    const uint64_t increment = 1;
+
+    if (write(this->wakeupDescriptor, &increment, sizeof(increment)) < 0)
+    {
+        ReportWarning("[Notifications] Cannot wake up listener thread");
+    }
+}
+
+void
+Database::Notifications::dispatchTriggered()
+{
+    uint64_t counter;
+
+    if (read(this->wakeupDescriptor, &counter, sizeof(counter)) < 0)
+    { }
+
+    std::set<std::string> channels;
+
+    {
+        std::unique_lock<std::mutex> subscriptionsLock { this->subscriptions.lock };
+
+        channels.swap(this->subscriptions.triggered);
+    }
+
+    for (const std::string& channel : channels)
+    {
+        this->dispatch(channel);
+    }
+}
+
+void
+Database::Notifications::dispatch(const std::string& channel)
+{
+    std::vector<Database::NotificationHandler> handlers;
+
+    {
+        std::unique_lock<std::mutex> subscriptionsLock { this->subscriptions.lock };
+
+        auto subscription = this->subscriptions.handlers.find(channel);
+        if (subscription == this->subscriptions.handlers.end())
+            return;
+
+        handlers = subscription->second;
+    }
+
+    for (Database::NotificationHandler& handler : handlers)
+    {
+        try
+        {
+            handler();
+        }
+        catch (std::exception& exception)
+        {
+            ReportError("[Notifications] Handler for \"%s\" failed: %s",
+                    channel.c_str(),
+                    exception.what());
+        }
+    }
+}
+
+void
+Database::Notifications::dispatchAll()
+{
+    std::vector<std::string> channels;
+
+    {
+        std::unique_lock<std::mutex> subscriptionsLock { this->subscriptions.lock };
+
+        // Triggered channels are covered as well.
+        //
+        this->subscriptions.triggered.clear();
+
+        for (auto& subscription : this->subscriptions.handlers)
+        {
+            channels.push_back(subscription.first);
+        }
+    }
+
+    for (std::string& channel : channels)
+    {
+        this->dispatch(channel);
+    }
+}
+
+/**
+ * @brief   Thread handler for notification listener.
+ */
+void
+Database::Notifications::ThreadHandler(Database::Notifications* notifications)
+{
+    ReportNotice("[Notifications] Listener thread has been started");
+
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    const std::string portNumber = std::to_string(configuration.database.portNumber);
+
+    // Endless loop. In case connection breaks, it is established again
+    // at the beginning of the loop.
+    //
+    for (;;)
+    {
+        PGconn* connection = PQsetdbLogin(
+                configuration.database.hostName.c_str(),
+                portNumber.c_str(),
+                NULL,
+                NULL,
+                configuration.database.databaseName.c_str(),
+                configuration.database.role.c_str(),
+                configuration.database.password.c_str());
+
+        bool listening = (PQstatus(connection) == CONNECTION_OK);
+
+        if (listening == false)
+        {
+            ReportError("[Notifications] Cannot connect to database: %s",
+                    PQerrorMessage(connection));
+        }
+
+        std::vector<std::string> channels;
+
+        if (listening == true)
+        {
+            std::unique_lock<std::mutex> subscriptionsLock { notifications->subscriptions.lock };
+
+            for (auto& subscription : notifications->subscriptions.handlers)
+            {
+                channels.push_back(subscription.first);
+            }
+        }
+
+        for (std::string& channel : channels)
+        {
+            char* escapedChannel = PQescapeIdentifier(connection, channel.c_str(), channel.length());
+
+            const std::string command = std::string("LISTEN ") + escapedChannel;
+
+            PQfreemem(escapedChannel);
+
+            PGresult* result = PQexec(connection, command.c_str());
+
+            if (PQresultStatus(result) != PGRES_COMMAND_OK)
+            {
+                ReportError("[Notifications] Cannot listen to \"%s\": %s",
+                        channel.c_str(),
+                        PQerrorMessage(connection));
+
+                listening = false;
+            }
+
+            PQclear(result);
+        }
+
+        if (listening == true)
+        {
+            // Whatever has been notified before LISTEN has been missed.
+            //
+            notifications->dispatchAll();
+        }
+
+        while (listening == true)
+        {
+            struct pollfd descriptors[2];
+            descriptors[0].fd = PQsocket(connection);
+            descriptors[0].events = POLLIN;
+            descriptors[0].revents = 0;
+            descriptors[1].fd = notifications->wakeupDescriptor;
+            descriptors[1].events = POLLIN;
+            descriptors[1].revents = 0;
+
+            if (poll(descriptors, 2, Database::NotificationsPollInterval) < 0)
+                continue;
+
+            if ((descriptors[1].revents & POLLIN) != 0)
+                notifications->dispatchTriggered();
+
+            if (PQconsumeInput(connection) == 0)
+            {
+                ReportWarning("[Notifications] Connection is broken: %s",
+                        PQerrorMessage(connection));
+
+                listening = false;
+
+                continue;
+            }
+
+            PGnotify* notify;
+
+            while ((notify = PQnotifies(connection)) != NULL)
+            {
+                ReportDebug("[Notifications] Received notification on \"%s\"",
+                        notify->relname);
+
+                const std::string channel = notify->relname;
+
+                PQfreemem(notify);
+
+                notifications->dispatch(channel);
+            }
+        }
+
+        PQfinish(connection);
+
+        std::this_thread::sleep_for(
+                std::chrono::seconds { Database::NotificationsPauseBeforeReconnect });
+    }
+
+    ReportWarning("[Notifications] Listener thread is going to quit");
+}
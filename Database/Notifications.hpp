@@ -0,0 +1,107 @@
+#pragma once
+
+// System definition files.
+//
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Database
+{
+    static const unsigned int NotificationsPauseBeforeReconnect     = 10;       /**< Seconds. */
+    static const unsigned int NotificationsPollInterval             = 60000;    /**< Milliseconds. */
+
+    /**
+     * Channel notified whenever DS18B20/DS18S20 or DHT11/DHT22 sensors are added, removed or changed.
+     */
+    static const std::string SensorsChannel = "primus_sensors";
+
+    /**
+     * Channel notified whenever a servus is added, removed or changed.
+     */
+    static const std::string ServusesChannel = "primus_servuses";
+
+    /**
+     * Channel notified whenever anything servus configuration is generated from is changed.
+     */
+    static const std::string ConfigurationChannel = "primus_configuration";
+
+    /**
+     * Channel triggered from within Primus only, whenever a reading carries an unknown sensor token.
+     * Unlike sensors channel, it does not invalidate servus configurations.
+     */
+    static const std::string SensorTokensChannel = "primus_sensor_tokens";
+
+    typedef std::function<void()> NotificationHandler;
+
+    /**
+     * Receiver of PostgreSQL NOTIFY events.
+     *
+     * Runs its own database connection which does nothing but LISTEN.
+     * Every handler is also called after the connection has been (re)established,
+     * because notifications sent in the meantime are lost.
+     * Channels are sent by triggers defined in Database/Schema/Notifications.sql.
+     */
+    class Notifications
+    {
+    private:
+        /**
+         * Thread handler of listener thread.
+         */
+        std::thread thread;
+
+        struct
+        {
+            std::mutex lock;
+            std::map<std::string, std::vector<Database::NotificationHandler>> handlers;
+
+            /**
+             * Channels triggered from within Primus, dispatched by listener thread.
+             */
+            std::set<std::string> triggered;
+        }
+        subscriptions;
+
+        /**
+         * Event descriptor waking up listener thread once a channel is triggered.
+         */
+        int wakeupDescriptor;
+
+    public:
+        Notifications();
+
+        static Database::Notifications&
+        InitInstance();
+
+        static Database::Notifications&
+        SharedInstance();
+
+        void
+        startService();
+
+        void
+        subscribe(
+            const std::string&              channel,
+            Database::NotificationHandler   handler);
+
+        void
+        trigger(const std::string& channel);
+
+    private:
+        void
+        dispatchTriggered();
+
+        void
+        dispatch(const std::string& channel);
+
+        void
+        dispatchAll();
+
+        static void
+        ThreadHandler(Database::Notifications*);
+    };
+};
@@ -11,6 +11,7 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
 #include "Primus/Database/Database.hpp"
 #include "Primus/Database/Phoenix.hpp"
 #include "Primus/Database/Queries/Phoenix.h"
@@ -31,22 +32,8 @@ Database::Phoenix::Phoenix(const unsigned long phoenixId)
         query.execute(QuerySearchForPhoenixById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(7);
-        query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(1, PostgreSQL::INT8OID);
-        query.assertColumnOfType(2, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(3, PostgreSQL::VARCHAROID);
-        query.assertColumnOfType(4, PostgreSQL::VARCHAROID);
-        query.assertColumnOfType(5, PostgreSQL::VARCHAROID);
-        query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
-
-        this->timestamp         = query.popTIMESTAMP();
-        this->phoenixId         = query.popBIGINT();
-        this->token             = query.popUUID();
-        this->deviceName        = query.popVARCHAR();
-        this->deviceModel       = query.popVARCHAR();
-        this->softwareVersion   = query.popVARCHAR();
-        this->title             = query.popVARCHAR();
+
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -63,12 +50,33 @@ Database::Phoenix::Phoenix(const unsigned long phoenixId)
     }
 }
 
-Database::Phoenix::~Phoenix()
+/**
+ * @brief   Load phoenix from current row of a query selecting the same columns as by id.
+ */
+Database::Phoenix::Phoenix(PostgreSQL::Query& query)
 {
-    if (this->timestamp != NULL)
-    {
-        delete this->timestamp;
-    }
+    this->loadRow(query);
+}
+
+void
+Database::Phoenix::loadRow(PostgreSQL::Query& query)
+{
+    query.assertNumberOfColumns(7);
+    query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(1, PostgreSQL::INT8OID);
+    query.assertColumnOfType(2, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(3, PostgreSQL::VARCHAROID);
+    query.assertColumnOfType(4, PostgreSQL::VARCHAROID);
+    query.assertColumnOfType(5, PostgreSQL::VARCHAROID);
+    query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
+
+    this->timestamp         = Primus::PopTimestamp(query);
+    this->phoenixId         = query.popBIGINT();
+    this->token             = Primus::UUID::FromString(query.popUUID());
+    this->deviceName        = query.popVARCHAR();
+    this->deviceModel       = query.popVARCHAR();
+    this->softwareVersion   = query.popVARCHAR();
+    this->title             = query.popVARCHAR();
 }
 
 void
@@ -231,7 +239,7 @@ Database::Phoenix::numberOfNotifications()
 unsigned long
 Database::Phoenix::RegisterPhoenixWithActivationCode(
     const std::string&  activationCode,
-    const std::string&  vendorToken,
+    const Primus::UUID& vendorToken,
     const std::string&  deviceName,
     const std::string&  deviceModel,
     const std::string&  softwareVersion,
@@ -274,7 +282,9 @@ Database::Phoenix::RegisterPhoenixWithActivationCode(
             {
                 PostgreSQL::Query query(database.connection());
 
-                query.pushUUID(&vendorToken);
+                const std::string vendorTokenQuery = vendorToken.asString();
+
+                query.pushUUID(&vendorTokenQuery);
                 query.pushVARCHAR(&deviceName);
                 query.pushVARCHAR(&deviceModel);
                 query.pushVARCHAR(&softwareVersion);
@@ -6,19 +6,24 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "APNS/APNS.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class Phoenix
     {
     public:
-        Toolkit::Timestamp* timestamp;
+        Toolkit::Timestamp  timestamp;
         unsigned long       phoenixId;
-        std::string         token;
+        Primus::UUID        token;
         char                deviceToken[APNS::DeviceTokenLength];
-        std::string         vendorToken;
+        Primus::UUID        vendorToken;
         std::string         deviceName;
         std::string         deviceModel;
         std::string         softwareVersion;
@@ -27,7 +32,7 @@ namespace Database
     public:
         Phoenix(const unsigned long phoenixId);
 
-        ~Phoenix();
+        Phoenix(PostgreSQL::Query& query);
 
         void
         saveDeviceToken();
@@ -44,10 +49,14 @@ namespace Database
         static unsigned long
         RegisterPhoenixWithActivationCode(
             const std::string&  activationCode,
-            const std::string&  vendorToken,
+            const Primus::UUID& vendorToken,
             const std::string&  deviceName,
             const std::string&  deviceModel,
             const std::string&  softwareVersion,
             const std::string&  title);
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
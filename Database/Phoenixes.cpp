@@ -10,7 +10,9 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
 #include "Primus/Database/Database.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Phoenix.hpp"
 #include "Primus/Database/Phoenixes.hpp"
 #include "Primus/Database/Queries/Phoenix.h"
@@ -53,7 +55,7 @@ Database::Phoenixes::TotalNumber()
     return numberOfPhoenixes;
 }
 
-Database::Phoenix&
+Database::Phoenix
 Database::Phoenixes::PhoenixByIndex(const unsigned long phoenixIndex)
 {
     unsigned long phoenixId;
@@ -94,8 +96,8 @@ Database::Phoenixes::PhoenixByIndex(const unsigned long phoenixIndex)
     return Database::Phoenixes::PhoenixById(phoenixId);
 }
 
-Database::Phoenix&
-Database::Phoenixes::PhoenixByToken(const std::string& phoenixToken)
+Database::Phoenix
+Database::Phoenixes::PhoenixByToken(const Primus::UUID& phoenixToken)
 {
     unsigned long phoenixId;
 
@@ -107,7 +109,9 @@ Database::Phoenixes::PhoenixByToken(const std::string& phoenixToken)
 
         PostgreSQL::Query query(database.connection());
 
-        query.pushUUID(&phoenixToken);
+        const std::string phoenixTokenQuery = phoenixToken.asString();
+
+        query.pushUUID(&phoenixTokenQuery);
         query.execute(QuerySearchForPhoenixByToken);
 
         query.assertNumberOfRows(1);
@@ -133,12 +137,52 @@ Database::Phoenixes::PhoenixByToken(const std::string& phoenixToken)
     return Database::Phoenixes::PhoenixById(phoenixId);
 }
 
-Database::Phoenix&
+Database::Phoenix
 Database::Phoenixes::PhoenixById(const unsigned long phoenixId)
 {
-    Database::Phoenix* phoenix = new Database::Phoenix(phoenixId);
+    return Database::Phoenix(phoenixId);
+}
+
+/**
+ * @brief   Load all phoenixes with one query, in the order they are listed.
+ */
+Database::EntityList<Database::Phoenix>
+Database::Phoenixes::AllPhoenixes()
+{
+    Database::EntityList<Database::Phoenix> phoenixes;
+
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        PostgreSQL::Query query(database.connection());
+
+        query.execute(QueryAllPhoenixes);
+
+        while (query.reachedLastRow() == false)
+        {
+            phoenixes.emplace_back(query);
+
+            query.nextRow();
+        }
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot load list of phoenixes: %s",
+                exception.what());
+
+        throw exception;
+    }
 
-    return *phoenix;
+    return phoenixes;
 }
 
 void
@@ -6,6 +6,8 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Phoenix.hpp"
 
 namespace Database
@@ -16,15 +18,18 @@ namespace Database
         static unsigned long
         TotalNumber();
 
-        static Database::Phoenix&
+        static Database::Phoenix
         PhoenixByIndex(const unsigned long);
 
-        static Database::Phoenix&
-        PhoenixByToken(const std::string&);
+        static Database::Phoenix
+        PhoenixByToken(const Primus::UUID&);
 
-        static Database::Phoenix&
+        static Database::Phoenix
         PhoenixById(const unsigned long);
 
+        static Database::EntityList<Database::Phoenix>
+        AllPhoenixes();
+
         static void
         RemovePhoenixById(const unsigned long);
     };
@@ -15,6 +15,11 @@ SELECT activator_stamp, activator_id, activator_token, phoenix_id, activation_co
 FROM kernel.activators \
 WHERE activator_id = $1"
 
+#define QueryAllActivators "\
+SELECT activator_stamp, activator_id, activator_token, phoenix_id, activation_code, title \
+FROM kernel.activators \
+ORDER BY activator_id DESC"
+
 #define QueryInsertActivator "\
 INSERT INTO kernel.activators (activation_code, title) \
 VALUES($1, $2) \
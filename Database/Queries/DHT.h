@@ -4,6 +4,10 @@
 SELECT COUNT(*) \
 FROM kernel.dhts"
 
+#define QueryAllDHTSensorTokens "\
+SELECT dht_token, dht_id \
+FROM kernel.dhts"
+
 #define QuerySearchForDHTSensorByIndex "\
 SELECT dht_id \
 FROM kernel.dhts \
@@ -15,17 +19,10 @@ SELECT dht_stamp, dht_id, dht_token, servus_id, gpio_pin_number, humidity_edge,
 FROM kernel.dhts \
 WHERE dht_id = $1"
 
-#define QueryInsertDHTSensorHumidity "\
-INSERT INTO journal.dht_humidities (humidity_stamp, dht_id, original_stamp, humidity) \
-SELECT $1, dht_id, $3, $4 \
-FROM kernel.dhts \
-WHERE dht_token = $2"
-
-#define QueryInsertDHTSensorTemperature "\
-INSERT INTO journal.dht_temperatures (temperature_stamp, dht_id, original_stamp, temperature) \
-SELECT $1, dht_id, $3, $4 \
+#define QueryAllDHTSensors "\
+SELECT dht_stamp, dht_id, dht_token, servus_id, gpio_pin_number, humidity_edge, temperature_edge, title \
 FROM kernel.dhts \
-WHERE dht_token = $2"
+ORDER BY list_order ASC"
 
 #define QueryDHTSensorLastKnownHumidity "\
 SELECT humidity \
@@ -2,9 +2,8 @@
 
 #define QueryBeginServusSession "\
 INSERT INTO debug.servus_sessions \
-(servus_ip) \
-VALUES($1) \
-RETURNING session_id"
+(session_id, servus_ip) \
+VALUES($1, $2)"
 
 #define QueryCloseServusSession "\
 UPDATE debug.servus_sessions \
@@ -23,9 +22,8 @@ VALUES ($1, $2, $3)"
 
 #define QueryBeginPhoenixSession "\
 INSERT INTO debug.phoenix_sessions \
-(phoenix_ip) \
-VALUES($1) \
-RETURNING session_id"
+(session_id, phoenix_ip) \
+VALUES($1, $2)"
 
 #define QueryClosePhoenixSession "\
 UPDATE debug.phoenix_sessions \
@@ -41,3 +39,21 @@ WHERE session_id = $1"
 INSERT INTO debug.phoenix_rtsp \
 (session_id, request_payload, response_payload, response_status) \
 VALUES ($1, $2, $3, $4)"
+
+// Batched inserts are composed of a head and one row per request/response pair.
+//
+#define QueryReportServusRTSPHead "\
+INSERT INTO debug.servus_rtsp \
+(session_id, request_payload, response_payload) \
+VALUES "
+
+#define QueryReportServusRTSPRow "\
+($%u, $%u, $%u)"
+
+#define QueryReportPhoenixRTSPHead "\
+INSERT INTO debug.phoenix_rtsp \
+(session_id, request_payload, response_payload, response_status) \
+VALUES "
+
+#define QueryReportPhoenixRTSPRow "\
+($%u, $%u, $%u, $%u)"
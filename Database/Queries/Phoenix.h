@@ -20,6 +20,11 @@ SELECT phoenix_stamp, phoenix_id, phoenix_token, device_name, device_model, soft
 FROM kernel.phoenixes \
 WHERE phoenix_id = $1"
 
+#define QueryAllPhoenixes "\
+SELECT phoenix_stamp, phoenix_id, phoenix_token, device_name, device_model, software_version, title \
+FROM kernel.phoenixes \
+ORDER BY phoenix_id DESC"
+
 #define QuerySearchForActivatorByCode "\
 SELECT activator_id \
 FROM kernel.activators \
@@ -0,0 +1,19 @@
+#pragma once
+
+// Multi-row inserts are composed of a head and one row per reading.
+// Each row takes four parameters: origin timestamp, sensor id, original stamp and value.
+//
+#define QueryInsertReadingsRow "\
+($%u::TIMESTAMP, $%u::BIGINT, $%u::DOUBLE PRECISION, $%u::REAL)"
+
+#define QueryInsertDSSensorTemperaturesHead "\
+INSERT INTO journal.temperatures (temperature_stamp, therma_id, original_stamp, temperature) \
+VALUES "
+
+#define QueryInsertDHTSensorTemperaturesHead "\
+INSERT INTO journal.dht_temperatures (temperature_stamp, dht_id, original_stamp, temperature) \
+VALUES "
+
+#define QueryInsertDHTSensorHumiditiesHead "\
+INSERT INTO journal.dht_humidities (humidity_stamp, dht_id, original_stamp, humidity) \
+VALUES "
@@ -15,6 +15,11 @@ SELECT relay_stamp, relay_id, relay_token, servus_id, gpio_pin_number, relay_sta
 FROM kernel.relays \
 WHERE relay_id = $1"
 
+#define QueryAllRelays "\
+SELECT relay_stamp, relay_id, relay_token, servus_id, gpio_pin_number, relay_state, title \
+FROM kernel.relays \
+ORDER BY list_order ASC"
+
 #define QueryUpdateRelayTitle "\
 UPDATE kernel.relays \
 SET title = $2 \
@@ -20,6 +20,11 @@ SELECT servus_stamp, servus_id, servus_token, enabled, online, running_since, au
 FROM kernel.servuses \
 WHERE servus_id = $1"
 
+#define QueryAllServuses "\
+SELECT servus_stamp, servus_id, servus_token, enabled, online, running_since, authenticator, title \
+FROM kernel.servuses \
+ORDER BY list_order ASC"
+
 #define QueryServusConfiguration "\
 SELECT kernel.servus_configuration($1)"
 
@@ -34,15 +39,20 @@ SET title = $2 \
 WHERE servus_id = $1 \
 RETURNING title"
 
-#define QueryServusSetOnline "\
-UPDATE kernel.servuses \
-SET online = TRUE \
-WHERE servus_id = $1"
+// Online status of servuses is updated with one statement composed of a head,
+// one row per servus and a tail. Each row takes two parameters: servus id and online status.
+//
+#define QueryServusesSetOnlineHead "\
+UPDATE kernel.servuses AS servuses \
+SET online = presence.online \
+FROM (VALUES "
 
-#define QueryServusSetOffline "\
-UPDATE kernel.servuses \
-SET online = FALSE \
-WHERE servus_id = $1"
+#define QueryServusesSetOnlineRow "\
+($%u::BIGINT, $%u::BOOLEAN)"
+
+#define QueryServusesSetOnlineTail "\
+) AS presence (servus_id, online) \
+WHERE servuses.servus_id = presence.servus_id"
 
 #define QueryToggleServusEnabledFlag "\
 UPDATE kernel.servuses \
@@ -4,6 +4,10 @@
 SELECT COUNT(*) \
 FROM kernel.thermas"
 
+#define QueryAllDSSensorTokens "\
+SELECT therma_token, therma_id \
+FROM kernel.thermas"
+
 #define QuerySearchForDSSensorByIndex "\
 SELECT therma_id \
 FROM kernel.thermas \
@@ -15,18 +19,17 @@ SELECT therma_stamp, therma_id, therma_token, servus_id, gpio_device_number, tem
 FROM kernel.thermas \
 WHERE therma_id = $1"
 
+#define QueryAllDSSensors "\
+SELECT therma_stamp, therma_id, therma_token, servus_id, gpio_device_number, temperature_edge, title \
+FROM kernel.thermas \
+ORDER BY list_order ASC"
+
 #define QueryUpdateDSSensorTitle "\
 UPDATE kernel.thermas \
 SET title = $2 \
 WHERE therma_id = $1 \
 RETURNING title"
 
-#define QueryInsertDSSensorTemperature "\
-INSERT INTO journal.temperatures (temperature_stamp, therma_id, original_stamp, temperature) \
-SELECT $1, therma_id, $3, $4 \
-FROM kernel.thermas \
-WHERE therma_token = $2"
-
 #define QueryDSSensorLastKnownTemperature "\
 SELECT temperature \
 FROM journal.temperatures \
@@ -0,0 +1,190 @@
+// System definition files.
+//
+#include <endian.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Common definition files.
+//
+#include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Report.h"
+#include "Toolkit/Times.hpp"
+
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+#include "Primus/Database/Database.hpp"
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Database/Queries/Reading.h"
+
+/**
+ * Network byte order representation of reading values.
+ * Query keeps pointers to pushed values until it is executed,
+ * therefore they have to stay in place for the whole lifetime of the query.
+ */
+struct ReadingParameters
+{
+    union
+    {
+        unsigned long   stampInteger;
+        double          stampReal;
+    };
+
+    unsigned long   sensorId;
+
+    union
+    {
+        unsigned int    valueInteger;
+        float           valueReal;
+    };
+};
+
+static void
+InsertReadingsOfKind(
+    PostgreSQL::Connection&             connection,
+    std::vector<Database::Reading>&     readings,
+    const Database::ReadingKind         kind,
+    const char* const                   queryHead);
+
+/**
+ * Origin stamp is taken over, so that it is allocated only once
+ * while a reading travels from datagram to database.
+ */
+Database::Reading::Reading(
+    const ReadingKind   kind,
+    std::string         originStamp,
+    const double        stampAsReal,
+    const Primus::UUID& sensorToken,
+    const float         value) :
+kind(kind),
+originStamp(std::move(originStamp)),
+sensorToken(sensorToken),
+sensorId(0),
+stampAsReal(stampAsReal),
+value(value)
+{ }
+
+/**
+ * @brief   Store a batch of sensor readings within one transaction.
+ *
+ * Readings are split by kind and every kind is stored with one multi-row insert.
+ *
+ * @param   readings        Readings to be stored.
+ */
+void
+Database::NoticeSensorReadings(std::vector<Database::Reading>& readings)
+{
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Sensors);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        PostgreSQL::Transaction transaction(database.connection());
+
+        InsertReadingsOfKind(
+                database.connection(),
+                readings,
+                Database::DSTemperature,
+                QueryInsertDSSensorTemperaturesHead);
+
+        InsertReadingsOfKind(
+                database.connection(),
+                readings,
+                Database::DHTTemperature,
+                QueryInsertDHTSensorTemperaturesHead);
+
+        InsertReadingsOfKind(
+                database.connection(),
+                readings,
+                Database::DHTHumidity,
+                QueryInsertDHTSensorHumiditiesHead);
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot store sensor readings: %s",
+                exception.what());
+
+        throw exception;
+    }
+}
+
+static void
+InsertReadingsOfKind(
+    PostgreSQL::Connection&             connection,
+    std::vector<Database::Reading>&     readings,
+    const Database::ReadingKind         kind,
+    const char* const                   queryHead)
+{
+    std::vector<ReadingParameters> parameters;
+    parameters.reserve(readings.size());
+
+    // Origin timestamps are converted exactly as they always have been,
+    // so that stored timestamps do not depend on how the stamp has been parsed.
+    //
+    std::vector<Toolkit::Timestamp> originTimestamps;
+    originTimestamps.reserve(readings.size());
+
+    std::string queryText = queryHead;
+
+    PostgreSQL::Query query(connection);
+
+    unsigned int parameterNumber = 1;
+
+    for (Database::Reading& reading : readings)
+    {
+        if (reading.kind != kind)
+            continue;
+
+        parameters.emplace_back();
+
+        ReadingParameters& binary = parameters.back();
+
+        memcpy(&binary.stampInteger, &reading.stampAsReal, sizeof(reading.stampAsReal));
+        binary.stampInteger = htobe64(binary.stampInteger);
+
+        binary.sensorId = htobe64(reading.sensorId);
+
+        memcpy(&binary.valueInteger, &reading.value, sizeof(reading.value));
+        binary.valueInteger = htobe32(binary.valueInteger);
+
+        originTimestamps.emplace_back(reading.originStamp);
+
+        char row[100];
+
+        snprintf(row, sizeof(row),
+                QueryInsertReadingsRow,
+                parameterNumber,
+                parameterNumber + 1,
+                parameterNumber + 2,
+                parameterNumber + 3);
+
+        if (parameterNumber > 1)
+            queryText += ", ";
+
+        queryText += row;
+
+        query.pushTIMESTAMP(originTimestamps.back());
+        query.pushBIGINT(&binary.sensorId);
+        query.pushDOUBLE(&binary.stampReal);
+        query.pushREAL(&binary.valueReal);
+
+        parameterNumber += 4;
+    }
+
+    // Nothing to store for this kind of readings.
+    //
+    if (parameterNumber == 1)
+        return;
+
+    query.execute(queryText.c_str());
+}
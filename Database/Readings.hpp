@@ -0,0 +1,42 @@
+#pragma once
+
+// System definition files.
+//
+#include <string>
+#include <vector>
+
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
+namespace Database
+{
+    enum ReadingKind
+    {
+        DSTemperature,
+        DHTTemperature,
+        DHTHumidity
+    };
+
+    class Reading
+    {
+    public:
+        ReadingKind         kind;
+        std::string         originStamp;        /**< Timestamp as provided by servus, kept for spool. */
+        Primus::UUID        sensorToken;
+        unsigned long       sensorId;           /**< Resolved from sensor token before deposit. */
+        double              stampAsReal;        /**< Seconds since epoch, parsed once from origin stamp. */
+        float               value;
+
+    public:
+        Reading(
+            const ReadingKind   kind,
+            std::string         originStamp,
+            const double        stampAsReal,
+            const Primus::UUID& sensorToken,
+            const float         value);
+    };
+
+    void
+    NoticeSensorReadings(std::vector<Database::Reading>&);
+};
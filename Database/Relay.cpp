@@ -31,22 +31,8 @@ Database::Relay::Relay(const unsigned long relayId)
         query.execute(QuerySearchForRelayById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(7);
-        query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(1, PostgreSQL::INT8OID);
-        query.assertColumnOfType(2, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(3, PostgreSQL::INT8OID);
-        query.assertColumnOfType(4, PostgreSQL::INT4OID);
-        query.assertColumnOfType(5, PostgreSQL::BOOLOID);
-        query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
-
-        this->timestamp         = query.popTIMESTAMP();
-        this->relayId           = query.popBIGINT();
-        this->token             = query.popUUID();
-        this->servusId          = query.popBIGINT();
-        this->gpioPinNumber     = query.popINTEGER();
-        this->state             = query.popBOOLEAN();
-        this->title             = query.popVARCHAR();
+
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -63,12 +49,33 @@ Database::Relay::Relay(const unsigned long relayId)
     }
 }
 
-Database::Relay::~Relay()
+/**
+ * @brief   Load relay from current row of a query selecting the same columns as by id.
+ */
+Database::Relay::Relay(PostgreSQL::Query& query)
 {
-    if (this->timestamp != NULL)
-    {
-        delete this->timestamp;
-    }
+    this->loadRow(query);
+}
+
+void
+Database::Relay::loadRow(PostgreSQL::Query& query)
+{
+    query.assertNumberOfColumns(7);
+    query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(1, PostgreSQL::INT8OID);
+    query.assertColumnOfType(2, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(3, PostgreSQL::INT8OID);
+    query.assertColumnOfType(4, PostgreSQL::INT4OID);
+    query.assertColumnOfType(5, PostgreSQL::BOOLOID);
+    query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
+
+    this->timestamp         = Primus::PopTimestamp(query);
+    this->relayId           = query.popBIGINT();
+    this->token             = Primus::UUID::FromString(query.popUUID());
+    this->servusId          = query.popBIGINT();
+    this->gpioPinNumber     = query.popINTEGER();
+    this->state             = query.popBOOLEAN();
+    this->title             = query.popVARCHAR();
 }
 
 void
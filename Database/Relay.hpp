@@ -7,16 +7,21 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class Relay
     {
     public:
-        Toolkit::Timestamp* timestamp;
+        Toolkit::Timestamp  timestamp;
         unsigned long       relayId;
-        std::string         token;
+        Primus::UUID        token;
         unsigned long       servusId;
         unsigned int        gpioPinNumber;
         bool                state;
@@ -25,7 +30,7 @@ namespace Database
     public:
         Relay(const unsigned long relayId);
 
-        ~Relay();
+        Relay(PostgreSQL::Query& query);
 
         void
         setTitle(const std::string&);
@@ -38,5 +43,9 @@ namespace Database
         switchOff(),
         switchOn(),
         switchOver();
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
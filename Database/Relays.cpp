@@ -12,6 +12,7 @@
 // Local definition files.
 //
 #include "Primus/Database/Database.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Relay.hpp"
 #include "Primus/Database/Relays.hpp"
 #include "Primus/Database/Queries/Relay.h"
@@ -54,7 +55,7 @@ Database::Relays::TotalNumber()
     return numberOfRelays;
 }
 
-Database::Relay&
+Database::Relay
 Database::Relays::RelayByIndex(const unsigned long relayIndex)
 {
     unsigned long relayId;
@@ -95,10 +96,50 @@ Database::Relays::RelayByIndex(const unsigned long relayIndex)
     return Database::Relays::RelayById(relayId);
 }
 
-Database::Relay&
+Database::Relay
 Database::Relays::RelayById(const unsigned long relayId)
 {
-    Database::Relay* relay = new Database::Relay(relayId);
+    return Database::Relay(relayId);
+}
+
+/**
+ * @brief   Load all relays with one query, in the order they are listed.
+ */
+Database::EntityList<Database::Relay>
+Database::Relays::AllRelays()
+{
+    Database::EntityList<Database::Relay> relays;
+
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Sensors);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        PostgreSQL::Query query(database.connection());
+
+        query.execute(QueryAllRelays);
+
+        while (query.reachedLastRow() == false)
+        {
+            relays.emplace_back(query);
+
+            query.nextRow();
+        }
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot load list of relays: %s",
+                exception.what());
+
+        throw exception;
+    }
 
-    return *relay;
+    return relays;
 }
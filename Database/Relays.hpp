@@ -11,6 +11,7 @@
 
 // Local definition files.
 //
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Relay.hpp"
 
 namespace Database
@@ -21,11 +22,14 @@ namespace Database
         static unsigned long
         TotalNumber();
 
-        static Database::Relay&
+        static Database::Relay
         RelayByIndex(const unsigned long);
 
-        static Database::Relay&
+        static Database::Relay
         RelayById(const unsigned long);
+
+        static Database::EntityList<Database::Relay>
+        AllRelays();
     };
 
     class RelayNotFound : public std::runtime_error
@@ -0,0 +1,40 @@
+-- Notifications listened to by Primus (see Database/Notifications.hpp).
+--
+-- Primus keeps sensor tokens, servuses and servus configurations in memory
+-- and reloads them whenever one of these channels is notified. Has to be
+-- applied once to every database Primus runs against:
+--
+--     psql --dbname=<database> --file=Database/Schema/Notifications.sql
+--
+-- Without it, changes made outside of Primus become visible to it only
+-- after a restart or after a reconnect of its notification listener.
+
+CREATE OR REPLACE FUNCTION kernel.notify_primus()
+RETURNS TRIGGER
+LANGUAGE plpgsql
+AS $$
+BEGIN
+    PERFORM pg_notify(TG_ARGV[0], '');
+    RETURN NULL;
+END;
+$$;
+
+DROP TRIGGER IF EXISTS notify_primus_sensors ON kernel.thermas;
+CREATE TRIGGER notify_primus_sensors
+AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON kernel.thermas
+FOR EACH STATEMENT EXECUTE PROCEDURE kernel.notify_primus('primus_sensors');
+
+DROP TRIGGER IF EXISTS notify_primus_sensors ON kernel.dhts;
+CREATE TRIGGER notify_primus_sensors
+AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON kernel.dhts
+FOR EACH STATEMENT EXECUTE PROCEDURE kernel.notify_primus('primus_sensors');
+
+DROP TRIGGER IF EXISTS notify_primus_servuses ON kernel.servuses;
+CREATE TRIGGER notify_primus_servuses
+AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON kernel.servuses
+FOR EACH STATEMENT EXECUTE PROCEDURE kernel.notify_primus('primus_servuses');
+
+DROP TRIGGER IF EXISTS notify_primus_configuration ON kernel.relays;
+CREATE TRIGGER notify_primus_configuration
+AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON kernel.relays
+FOR EACH STATEMENT EXECUTE PROCEDURE kernel.notify_primus('primus_configuration');
@@ -0,0 +1,209 @@
+// System definition files.
+//
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Common definition files.
+//
+#include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+#include "Primus/Database/Database.hpp"
+#include "Primus/Database/Notifications.hpp"
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Database/SensorTokens.hpp"
+#include "Primus/Database/Queries/DHT.h"
+#include "Primus/Database/Queries/Therma.h"
+
+static Database::SensorTokens* instance = NULL;
+
+Database::SensorTokens&
+Database::SensorTokens::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[SensorTokens] Already initialized");
+
+    instance = new Database::SensorTokens();
+
+    return *instance;
+}
+
+Database::SensorTokens&
+Database::SensorTokens::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[SensorTokens] Not initialized");
+
+    return *instance;
+}
+
+Database::SensorTokens::SensorTokens()
+{
+    Database::Notifications& notifications = Database::Notifications::SharedInstance();
+
+    notifications.subscribe(Database::SensorsChannel,
+            [this]()
+            {
+                this->reload();
+            });
+
+    notifications.subscribe(Database::SensorTokensChannel,
+            [this]()
+            {
+                this->reload();
+            });
+
+    this->reload();
+}
+
+/**
+ * @brief   Load tokens of all sensors from database.
+ *
+ * Default connection is used, so that ingest writer is not held up
+ * on the sensors connection meanwhile.
+ */
+void
+Database::SensorTokens::reload()
+{
+    std::unordered_map<Primus::UUID, unsigned long> thermas;
+    std::unordered_map<Primus::UUID, unsigned long> dhts;
+
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        {
+            PostgreSQL::Query query(database.connection());
+
+            query.execute(QueryAllDSSensorTokens);
+
+            query.assertNumberOfColumns(2);
+            query.assertColumnOfType(0, PostgreSQL::UUIDOID);
+            query.assertColumnOfType(1, PostgreSQL::INT8OID);
+
+            while (query.reachedLastRow() == false)
+            {
+                const Primus::UUID sensorToken = Primus::UUID::FromString(query.popUUID());
+                const unsigned long sensorId = query.popBIGINT();
+
+                thermas[sensorToken] = sensorId;
+
+                query.nextRow();
+            }
+        }
+
+        {
+            PostgreSQL::Query query(database.connection());
+
+            query.execute(QueryAllDHTSensorTokens);
+
+            query.assertNumberOfColumns(2);
+            query.assertColumnOfType(0, PostgreSQL::UUIDOID);
+            query.assertColumnOfType(1, PostgreSQL::INT8OID);
+
+            while (query.reachedLastRow() == false)
+            {
+                const Primus::UUID sensorToken = Primus::UUID::FromString(query.popUUID());
+                const unsigned long sensorId = query.popBIGINT();
+
+                dhts[sensorToken] = sensorId;
+
+                query.nextRow();
+            }
+        }
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot load sensor tokens: %s",
+                exception.what());
+
+        throw exception;
+    }
+
+    ReportInfo("[Database] Loaded tokens of %lu DS18B20/DS18S20 and %lu DHT11/DHT22 sensors",
+            thermas.size(),
+            dhts.size());
+
+    std::unique_lock<std::mutex> tokensLock { this->lock };
+
+    this->thermas.swap(thermas);
+    this->dhts.swap(dhts);
+    this->lastReload = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief   Find database id of a sensor.
+ *
+ * Never touches the database. An unknown token has the tokens reloaded
+ * by notification listener thread, so that a sensor added without notification
+ * is known shortly after.
+ *
+ * @param   kind            Kind of reading which tells whether to look for DS or DHT sensor.
+ * @param   sensorToken     Sensor token as provided by servus.
+ * @param   sensorId        Found sensor id.
+ *
+ * @return  True if sensor is known, false otherwise.
+ */
+bool
+Database::SensorTokens::resolve(
+    const Database::ReadingKind kind,
+    const Primus::UUID&         sensorToken,
+    unsigned long&              sensorId)
+{
+    if (this->lookup(kind, sensorToken, sensorId) == true)
+        return true;
+
+    // Sensor could have been added since last reload without notification.
+    //
+    {
+        std::unique_lock<std::mutex> tokensLock { this->lock };
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (now < this->lastReload +
+                std::chrono::seconds { Database::SensorTokensReloadOnMissInterval })
+            return false;
+
+        this->lastReload = now;
+    }
+
+    Database::Notifications& notifications = Database::Notifications::SharedInstance();
+
+    notifications.trigger(Database::SensorTokensChannel);
+
+    return false;
+}
+
+bool
+Database::SensorTokens::lookup(
+    const Database::ReadingKind kind,
+    const Primus::UUID&         sensorToken,
+    unsigned long&              sensorId)
+{
+    std::unique_lock<std::mutex> tokensLock { this->lock };
+
+    const std::unordered_map<Primus::UUID, unsigned long>& sensors =
+            (kind == Database::DSTemperature) ? this->thermas : this->dhts;
+
+    auto sensor = sensors.find(sensorToken);
+    if (sensor == sensors.end())
+        return false;
+
+    sensorId = sensor->second;
+
+    return true;
+}
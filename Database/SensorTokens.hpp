@@ -0,0 +1,63 @@
+#pragma once
+
+// System definition files.
+//
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+#include "Primus/Database/Readings.hpp"
+
+namespace Database
+{
+    /**
+     * Minimal interval between reloads caused by unknown tokens.
+     */
+    static const unsigned int SensorTokensReloadOnMissInterval = 10;   /**< Seconds. */
+
+    /**
+     * In-memory map of sensor tokens to their database ids.
+     *
+     * Loaded at startup and reloaded whenever sensors channel is notified.
+     * An unknown token triggers a reload by notification listener as well, but not more often than
+     * once per SensorTokensReloadOnMissInterval. The reading carrying it is not waited for.
+     */
+    class SensorTokens
+    {
+    private:
+        std::mutex lock;
+
+        std::unordered_map<Primus::UUID, unsigned long> thermas;
+        std::unordered_map<Primus::UUID, unsigned long> dhts;
+        std::chrono::steady_clock::time_point           lastReload;
+
+    public:
+        static Database::SensorTokens&
+        InitInstance();
+
+        static Database::SensorTokens&
+        SharedInstance();
+
+        SensorTokens();
+
+        void
+        reload();
+
+        bool
+        resolve(
+            const Database::ReadingKind kind,
+            const Primus::UUID&         sensorToken,
+            unsigned long&              sensorId);
+
+    private:
+        bool
+        lookup(
+            const Database::ReadingKind kind,
+            const Primus::UUID&         sensorToken,
+            unsigned long&              sensorId);
+    };
+};
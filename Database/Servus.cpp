@@ -30,24 +30,8 @@ Database::Servus::Servus(const unsigned long servusId)
         query.execute(QuerySearchForServusById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(8);
-        query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(1, PostgreSQL::INT8OID);
-        query.assertColumnOfType(2, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(3, PostgreSQL::BOOLOID);
-        query.assertColumnOfType(4, PostgreSQL::BOOLOID);
-        query.assertColumnOfType(5, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(6, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(7, PostgreSQL::VARCHAROID);
-
-        this->timestamp     = query.popTIMESTAMP();
-        this->servusId      = query.popBIGINT();
-        this->token         = query.popUUID();
-        this->enabled       = query.popBOOLEAN();
-        this->online        = query.popBOOLEAN();
-        this->runningSince  = query.popTIMESTAMP();
-        this->authenticator = query.popUUID();
-        this->title         = query.popVARCHAR();
+
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -64,16 +48,39 @@ Database::Servus::Servus(const unsigned long servusId)
     }
 }
 
-Database::Servus::~Servus()
+/**
+ * @brief   Load servus from current row of a query selecting the same columns as by id.
+ */
+Database::Servus::Servus(PostgreSQL::Query& query)
 {
-    if (this->timestamp != NULL)
-    {
-        delete this->timestamp;
-    }
+    this->loadRow(query);
+}
+
+void
+Database::Servus::loadRow(PostgreSQL::Query& query)
+{
+    query.assertNumberOfColumns(8);
+    query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(1, PostgreSQL::INT8OID);
+    query.assertColumnOfType(2, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(3, PostgreSQL::BOOLOID);
+    query.assertColumnOfType(4, PostgreSQL::BOOLOID);
+    query.assertColumnOfType(5, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(6, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(7, PostgreSQL::VARCHAROID);
+
+    this->timestamp     = Primus::PopTimestamp(query);
+    this->servusId      = query.popBIGINT();
+    this->token         = Primus::UUID::FromString(query.popUUID());
+    this->enabled       = query.popBOOLEAN();
+    this->online        = query.popBOOLEAN();
+    this->runningSince  = Primus::PopTimestamp(query);
+    this->authenticator = Primus::UUID::FromString(query.popUUID());
+    this->title         = query.popVARCHAR();
 }
 
 std::string
-Database::Servus::configurationAsJSON()
+Database::Servus::configurationAsJSON() const
 {
     Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
 
@@ -157,77 +164,7 @@ Database::Servus::toggleEnabledFlag()
 }
 
 void
-Database::Servus::setOnline()
-{
-    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
-
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { database.lock };
-
-        PostgreSQL::Transaction transaction(database.connection());
-
-        {
-            PostgreSQL::Query query(database.connection());
-
-            unsigned long servusIdQuery = htobe64(this->servusId);
-
-            query.pushBIGINT(&servusIdQuery);
-            query.execute(QueryServusSetOnline);
-        }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
-    {
-        database.recover(exception);
-
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportError("[Database] Cannot update servus online status: %s",
-                exception.what());
-
-        throw exception;
-    }
-}
-
-void
-Database::Servus::setOffline()
-{
-    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
-
-    try
-    {
-        std::unique_lock<std::mutex> queueLock { database.lock };
-
-        PostgreSQL::Transaction transaction(database.connection());
-
-        {
-            PostgreSQL::Query query(database.connection());
-
-            unsigned long servusIdQuery = htobe64(this->servusId);
-
-            query.pushBIGINT(&servusIdQuery);
-            query.execute(QueryServusSetOffline);
-        }
-    }
-    catch (PostgreSQL::OperatorIntervention& exception)
-    {
-        database.recover(exception);
-
-        throw exception;
-    }
-    catch (PostgreSQL::Exception& exception)
-    {
-        ReportError("[Database] Cannot update servus online status: %s",
-                exception.what());
-
-        throw exception;
-    }
-}
-
-void
-Database::Servus::setRunningSince(Toolkit::Timestamp& runningSince)
+Database::Servus::setRunningSince(Toolkit::Timestamp& runningSince) const
 {
     Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
 
@@ -7,37 +7,46 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class Servus
     {
     public:
-        Toolkit::Timestamp* timestamp;
+        Toolkit::Timestamp  timestamp;
         unsigned long       servusId;
-        std::string         token;
+        Primus::UUID        token;
         bool                enabled;
         bool                online;
-        Toolkit::Timestamp* runningSince;
-        std::string         authenticator;
+        Toolkit::Timestamp  runningSince;
+        Primus::UUID        authenticator;
         std::string         title;
 
     public:
         Servus(const unsigned long servusId);
 
-        ~Servus();
+        Servus(PostgreSQL::Query& query);
 
         std::string
-        configurationAsJSON();
+        configurationAsJSON() const;
+
+        void
+        toggleEnabledFlag();
 
         void
-        toggleEnabledFlag(),
-        setOnline(),
-        setOffline(),
-        setRunningSince(Toolkit::Timestamp&);
+        setRunningSince(Toolkit::Timestamp&) const;
 
         void
         setTitle(const std::string&);
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
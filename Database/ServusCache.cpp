@@ -0,0 +1,109 @@
+// System definition files.
+//
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Database/Notifications.hpp"
+#include "Primus/Database/Servus.hpp"
+#include "Primus/Database/ServusCache.hpp"
+#include "Primus/Database/Servuses.hpp"
+
+static Database::ServusCache* instance = NULL;
+
+Database::ServusCache&
+Database::ServusCache::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[ServusCache] Already initialized");
+
+    instance = new Database::ServusCache();
+
+    return *instance;
+}
+
+Database::ServusCache&
+Database::ServusCache::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[ServusCache] Not initialized");
+
+    return *instance;
+}
+
+Database::ServusCache::ServusCache()
+{
+    this->generation = 0;
+
+    Database::Notifications& notifications = Database::Notifications::SharedInstance();
+
+    notifications.subscribe(Database::ServusesChannel,
+            [this]()
+            {
+                this->invalidate();
+            });
+}
+
+/**
+ * @brief   Find servus by its authenticator.
+ *
+ * Database is accessed only if servus is not cached yet.
+ *
+ * @param   authenticator   Authenticator as provided by servus.
+ *
+ * @return  Servus snapshot.
+ *
+ * @throw   Database::ServusNotFound    In case no servus has this authenticator.
+ */
+Database::ServusSnapshot
+Database::ServusCache::servusByAuthenticator(const Primus::UUID& authenticator)
+{
+    unsigned long generation;
+
+    {
+        std::unique_lock<std::mutex> cacheLock { this->lock };
+
+        auto servus = this->servuses.find(authenticator);
+        if (servus != this->servuses.end())
+            return servus->second;
+
+        generation = this->generation;
+    }
+
+    Database::ServusSnapshot servus =
+            std::make_shared<const Database::Servus>(
+                    Database::Servuses::ServusByAuthenticator(authenticator));
+
+    {
+        std::unique_lock<std::mutex> cacheLock { this->lock };
+
+        if (generation == this->generation)
+            this->servuses[authenticator] = servus;
+    }
+
+    return servus;
+}
+
+/**
+ * @brief   Drop all cached servuses.
+ *
+ * Sessions keep the snapshots they already hold.
+ */
+void
+Database::ServusCache::invalidate()
+{
+    std::unique_lock<std::mutex> cacheLock { this->lock };
+
+    this->servuses.clear();
+    this->generation++;
+
+    ReportDebug("[ServusCache] Invalidated");
+}
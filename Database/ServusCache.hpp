@@ -0,0 +1,57 @@
+#pragma once
+
+// System definition files.
+//
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+#include "Primus/Database/Servus.hpp"
+
+namespace Database
+{
+    /**
+     * Snapshot of a servus as loaded from database. Never modified once loaded,
+     * so it may be shared by any number of sessions.
+     */
+    typedef std::shared_ptr<const Database::Servus> ServusSnapshot;
+
+    /**
+     * In-memory map of servus authenticators to servus snapshots.
+     *
+     * Filled on demand by AUTH. Dropped completely whenever a servus is changed,
+     * either by WWW or by a notification on servuses channel.
+     */
+    class ServusCache
+    {
+    private:
+        std::mutex lock;
+
+        std::unordered_map<Primus::UUID, Database::ServusSnapshot>  servuses;
+
+        /**
+         * Incremented with every invalidation, so that a snapshot loaded
+         * while cache is being invalidated is not put into cache.
+         */
+        unsigned long generation;
+
+    public:
+        static Database::ServusCache&
+        InitInstance();
+
+        static Database::ServusCache&
+        SharedInstance();
+
+        ServusCache();
+
+        Database::ServusSnapshot
+        servusByAuthenticator(const Primus::UUID& authenticator);
+
+        void
+        invalidate();
+    };
+};
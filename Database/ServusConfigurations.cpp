@@ -0,0 +1,146 @@
+// System definition files.
+//
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Database/Notifications.hpp"
+#include "Primus/Database/Servus.hpp"
+#include "Primus/Database/ServusConfigurations.hpp"
+
+static Database::ServusConfigurations* instance = NULL;
+
+static std::string
+ConfigurationVersion(const std::string& json);
+
+Database::ServusConfigurations&
+Database::ServusConfigurations::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[ServusConfigurations] Already initialized");
+
+    instance = new Database::ServusConfigurations();
+
+    return *instance;
+}
+
+Database::ServusConfigurations&
+Database::ServusConfigurations::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[ServusConfigurations] Not initialized");
+
+    return *instance;
+}
+
+Database::ServusConfigurations::ServusConfigurations()
+{
+    this->generation = 0;
+
+    Database::Notifications& notifications = Database::Notifications::SharedInstance();
+
+    notifications.subscribe(Database::ConfigurationChannel,
+            [this]()
+            {
+                this->invalidate();
+            });
+
+    notifications.subscribe(Database::SensorsChannel,
+            [this]()
+            {
+                this->invalidate();
+            });
+}
+
+/**
+ * @brief   Get configuration of a servus.
+ *
+ * Database is accessed only if configuration is not cached yet.
+ *
+ * @param   servus          Servus whose configuration is requested.
+ *
+ * @return  Configuration snapshot.
+ *
+ * @throw   PostgreSQL::Exception   In case configuration cannot be generated.
+ */
+Database::ServusConfigurationSnapshot
+Database::ServusConfigurations::configurationOf(const Database::Servus& servus)
+{
+    unsigned long generation;
+
+    {
+        std::unique_lock<std::mutex> cacheLock { this->lock };
+
+        auto configuration = this->configurations.find(servus.servusId);
+        if (configuration != this->configurations.end())
+            return configuration->second;
+
+        generation = this->generation;
+    }
+
+    std::shared_ptr<Database::ServusConfiguration> configuration =
+            std::make_shared<Database::ServusConfiguration>();
+
+    configuration->json = servus.configurationAsJSON();
+    configuration->version = ConfigurationVersion(configuration->json);
+
+    {
+        std::unique_lock<std::mutex> cacheLock { this->lock };
+
+        if (generation == this->generation)
+            this->configurations[servus.servusId] = configuration;
+    }
+
+    return configuration;
+}
+
+/**
+ * @brief   Drop all cached configurations.
+ */
+void
+Database::ServusConfigurations::invalidate()
+{
+    std::unique_lock<std::mutex> cacheLock { this->lock };
+
+    this->configurations.clear();
+    this->generation++;
+
+    ReportDebug("[ServusConfigurations] Invalidated");
+}
+
+/**
+ * @brief   Generate version of configuration from its content.
+ *
+ * Version is a 64-bit FNV-1a hash of JSON, so it stays the same
+ * across restarts of Primus as long as configuration does not change.
+ *
+ * @param   json            Configuration as JSON.
+ *
+ * @return  Version as 16 hexadecimal digits.
+ */
+static std::string
+ConfigurationVersion(const std::string& json)
+{
+    unsigned long hash = 14695981039346656037UL;
+
+    for (const char character : json)
+    {
+        hash ^= (unsigned char) character;
+        hash *= 1099511628211UL;
+    }
+
+    char version[17];
+
+    snprintf(version, sizeof(version), "%016lx", hash);
+
+    return version;
+}
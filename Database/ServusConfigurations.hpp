@@ -0,0 +1,62 @@
+#pragma once
+
+// System definition files.
+//
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Local definition files.
+//
+#include "Primus/Database/Servus.hpp"
+
+namespace Database
+{
+    /**
+     * Configuration of a servus as generated by database.
+     */
+    struct ServusConfiguration
+    {
+        std::string     json;
+        std::string     version;        /**< Hash of JSON, changes whenever configuration changes. */
+    };
+
+    typedef std::shared_ptr<const Database::ServusConfiguration> ServusConfigurationSnapshot;
+
+    /**
+     * In-memory map of servus ids to their configurations.
+     *
+     * Filled on demand by SETUP. Dropped completely whenever sensors, relays
+     * or servuses are changed, either by WWW or by a notification on
+     * configuration or sensors channel.
+     */
+    class ServusConfigurations
+    {
+    private:
+        std::mutex lock;
+
+        std::unordered_map<unsigned long, Database::ServusConfigurationSnapshot> configurations;
+
+        /**
+         * Incremented with every invalidation, so that a configuration generated
+         * while cache is being invalidated is not put into cache.
+         */
+        unsigned long generation;
+
+    public:
+        static Database::ServusConfigurations&
+        InitInstance();
+
+        static Database::ServusConfigurations&
+        SharedInstance();
+
+        ServusConfigurations();
+
+        Database::ServusConfigurationSnapshot
+        configurationOf(const Database::Servus& servus);
+
+        void
+        invalidate();
+    };
+};
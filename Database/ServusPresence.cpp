@@ -0,0 +1,281 @@
+// System definition files.
+//
+#include <endian.h>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Common definition files.
+//
+#include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Report.h"
+#include "Toolkit/Times.hpp"
+
+// Local definition files.
+//
+#include "Primus/Database/Database.hpp"
+#include "Primus/Database/Servuses.hpp"
+#include "Primus/Database/ServusPresence.hpp"
+#include "Primus/Database/Queries/Servus.h"
+
+static Database::ServusPresence* instance = NULL;
+
+Database::ServusPresence&
+Database::ServusPresence::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[ServusPresence] Already initialized");
+
+    instance = new Database::ServusPresence();
+
+    return *instance;
+}
+
+Database::ServusPresence&
+Database::ServusPresence::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[ServusPresence] Not initialized");
+
+    return *instance;
+}
+
+/**
+ * Registry starts empty, so online status of all servuses is reset in database.
+ * It could be left "online" since last runtime of Primus.
+ */
+Database::ServusPresence::ServusPresence()
+{
+    Database::Servuses::ResetAllServuses();
+}
+
+void
+Database::ServusPresence::startService()
+{
+    this->thread = std::thread(&Database::ServusPresence::ThreadHandler, this);
+}
+
+/**
+ * @brief   Register authenticated session of a servus.
+ *
+ * @param   servusId        Servus id.
+ * @param   remoteAddress   IP address servus is connected from.
+ */
+void
+Database::ServusPresence::sessionOpened(
+    const unsigned long servusId,
+    const std::string&  remoteAddress)
+{
+    std::unique_lock<std::mutex> presenceLock { this->lock };
+
+    auto record = this->records.find(servusId);
+    if (record == this->records.end())
+    {
+        record = this->records.emplace(servusId, Database::ServusPresenceRecord()).first;
+
+        record->second.numberOfSessions = 0;
+        record->second.synchronizedOnline = false;
+    }
+
+    if (record->second.numberOfSessions == 0)
+    {
+        record->second.onlineSince = Toolkit::Timestamp();
+    }
+
+    record->second.numberOfSessions++;
+    record->second.remoteAddress = remoteAddress;
+    record->second.lastDatagram = Toolkit::Timestamp();
+}
+
+/**
+ * @brief   Unregister session of a servus.
+ *
+ * Servus stays online as long as it has another session, which is the case
+ * when it has reconnected before its previous session timed out.
+ *
+ * @param   servusId        Servus id.
+ */
+void
+Database::ServusPresence::sessionClosed(const unsigned long servusId)
+{
+    std::unique_lock<std::mutex> presenceLock { this->lock };
+
+    auto record = this->records.find(servusId);
+    if ((record == this->records.end()) || (record->second.numberOfSessions == 0))
+        return;
+
+    record->second.numberOfSessions--;
+}
+
+/**
+ * @brief   Note that a datagram of a servus has been processed.
+ *
+ * @param   servusId        Servus id.
+ */
+void
+Database::ServusPresence::datagramReceived(const unsigned long servusId)
+{
+    std::unique_lock<std::mutex> presenceLock { this->lock };
+
+    auto record = this->records.find(servusId);
+    if (record == this->records.end())
+        return;
+
+    record->second.lastDatagram = Toolkit::Timestamp();
+}
+
+/**
+ * @brief   Look up presence of a servus.
+ *
+ * @param   servusId        Servus id.
+ * @param   record          Copy of presence record, filled only if servus is online.
+ *
+ * @return  True if servus is online, false otherwise.
+ */
+bool
+Database::ServusPresence::online(
+    const unsigned long             servusId,
+    Database::ServusPresenceRecord& record)
+{
+    std::unique_lock<std::mutex> presenceLock { this->lock };
+
+    auto found = this->records.find(servusId);
+    if ((found == this->records.end()) || (found->second.numberOfSessions == 0))
+        return false;
+
+    record = found->second;
+
+    return true;
+}
+
+/**
+ * @brief   Write online status of servuses which have changed since last synchronization.
+ *
+ * All changes are written with one statement. Records of servuses
+ * which are offline in database as well are removed from registry.
+ */
+void
+Database::ServusPresence::synchronize()
+{
+    struct PresenceChange
+    {
+        unsigned long   servusId;
+        bool            online;
+    };
+
+    std::vector<PresenceChange> changes;
+
+    {
+        std::unique_lock<std::mutex> presenceLock { this->lock };
+
+        for (auto& record : this->records)
+        {
+            const bool online = (record.second.numberOfSessions != 0);
+
+            if (online == record.second.synchronizedOnline)
+                continue;
+
+            changes.push_back({ htobe64(record.first), online });
+        }
+    }
+
+    if (changes.empty() == true)
+        return;
+
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        std::string queryText = QueryServusesSetOnlineHead;
+
+        PostgreSQL::Query query(database.connection());
+
+        unsigned int parameterNumber = 1;
+
+        for (PresenceChange& change : changes)
+        {
+            char row[40];
+
+            snprintf(row, sizeof(row),
+                    QueryServusesSetOnlineRow,
+                    parameterNumber,
+                    parameterNumber + 1);
+
+            if (parameterNumber > 1)
+                queryText += ", ";
+
+            queryText += row;
+
+            query.pushBIGINT(&change.servusId);
+            query.pushBOOLEAN(&change.online);
+
+            parameterNumber += 2;
+        }
+
+        queryText += QueryServusesSetOnlineTail;
+
+        query.execute(queryText.c_str());
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot update servus online status: %s",
+                exception.what());
+
+        throw exception;
+    }
+
+    std::unique_lock<std::mutex> presenceLock { this->lock };
+
+    for (const PresenceChange& change : changes)
+    {
+        auto record = this->records.find(be64toh(change.servusId));
+        if (record == this->records.end())
+            continue;
+
+        record->second.synchronizedOnline = change.online;
+
+        // Servus could have reconnected in the meantime.
+        //
+        if ((change.online == false) && (record->second.numberOfSessions == 0))
+            this->records.erase(record);
+    }
+}
+
+/**
+ * @brief   Thread handler for synchronization thread.
+ */
+void
+Database::ServusPresence::ThreadHandler(Database::ServusPresence* presence)
+{
+    ReportNotice("[ServusPresence] Synchronization thread has been started");
+
+    for (;;)
+    {
+        std::this_thread::sleep_for(
+                std::chrono::milliseconds { Database::ServusPresenceSyncInterval });
+
+        try
+        {
+            presence->synchronize();
+        }
+        catch (std::exception&)
+        {
+            // Changes stay pending and are written with the next synchronization.
+        }
+    }
+
+    ReportWarning("[ServusPresence] Synchronization thread is going to quit");
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// System definition files.
+//
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Common definition files.
+//
+#include "Toolkit/Times.hpp"
+
+namespace Database
+{
+    /**
+     * Interval between synchronizations of online status with database.
+     */
+    static const unsigned int ServusPresenceSyncInterval = 5000;   /**< Milliseconds. */
+
+    struct ServusPresenceRecord
+    {
+        unsigned int        numberOfSessions;   /**< Sessions authenticated by servus. */
+        Toolkit::Timestamp  onlineSince;
+        std::string         remoteAddress;
+        Toolkit::Timestamp  lastDatagram;
+
+        /**
+         * Online status as last written to database.
+         */
+        bool                synchronizedOnline;
+    };
+
+    /**
+     * In-memory registry of connected servuses.
+     *
+     * Dispatcher sessions report connects, disconnects and datagrams here.
+     * Online status is written to database only periodically and only for
+     * servuses whose status has changed since the last synchronization,
+     * so that a servus reconnecting many times in a row causes at most one update.
+     */
+    class ServusPresence
+    {
+    private:
+        /**
+         * Thread handler of synchronization thread.
+         */
+        std::thread thread;
+
+        std::mutex                                                  lock;
+        std::unordered_map<unsigned long, ServusPresenceRecord>     records;
+
+    public:
+        static Database::ServusPresence&
+        InitInstance();
+
+        static Database::ServusPresence&
+        SharedInstance();
+
+        ServusPresence();
+
+        void
+        startService();
+
+        void
+        sessionOpened(
+            const unsigned long servusId,
+            const std::string&  remoteAddress);
+
+        void
+        sessionClosed(const unsigned long servusId);
+
+        void
+        datagramReceived(const unsigned long servusId);
+
+        bool
+        online(
+            const unsigned long             servusId,
+            Database::ServusPresenceRecord& record);
+
+    private:
+        void
+        synchronize();
+
+        static void
+        ThreadHandler(Database::ServusPresence*);
+    };
+};
@@ -10,6 +10,7 @@
 // Local definition files.
 //
 #include "Primus/Database/Database.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Servus.hpp"
 #include "Primus/Database/Servuses.hpp"
 #include "Primus/Database/Queries/Servus.h"
@@ -52,8 +53,8 @@ Database::Servuses::TotalNumber()
     return numberOfServuses;
 }
 
-Database::Servus&
-Database::Servuses::ServusByAuthenticator(const std::string& authenticator)
+Database::Servus
+Database::Servuses::ServusByAuthenticator(const Primus::UUID& authenticator)
 {
     unsigned long servusId;
 
@@ -65,7 +66,9 @@ Database::Servuses::ServusByAuthenticator(const std::string& authenticator)
 
         PostgreSQL::Query query(database.connection());
 
-        query.pushUUID(&authenticator);
+        const std::string authenticatorQuery = authenticator.asString();
+
+        query.pushUUID(&authenticatorQuery);
         query.execute(QuerySearchForServusByAuthenticator);
 
         query.assertNumberOfRows(1);
@@ -95,7 +98,7 @@ Database::Servuses::ServusByAuthenticator(const std::string& authenticator)
     return Database::Servuses::ServusById(servusId);
 }
 
-Database::Servus&
+Database::Servus
 Database::Servuses::ServusByIndex(const unsigned long servusIndex)
 {
     unsigned long servusId;
@@ -136,12 +139,52 @@ Database::Servuses::ServusByIndex(const unsigned long servusIndex)
     return Database::Servuses::ServusById(servusId);
 }
 
-Database::Servus&
+Database::Servus
 Database::Servuses::ServusById(const unsigned long servusId)
 {
-    Database::Servus* servus = new Database::Servus(servusId);
+    return Database::Servus(servusId);
+}
+
+/**
+ * @brief   Load all servuses with one query, in the order they are listed.
+ */
+Database::EntityList<Database::Servus>
+Database::Servuses::AllServuses()
+{
+    Database::EntityList<Database::Servus> servuses;
+
+    Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Default);
+
+    try
+    {
+        std::unique_lock<std::mutex> queueLock { database.lock };
+
+        PostgreSQL::Query query(database.connection());
+
+        query.execute(QueryAllServuses);
+
+        while (query.reachedLastRow() == false)
+        {
+            servuses.emplace_back(query);
+
+            query.nextRow();
+        }
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        database.recover(exception);
+
+        throw exception;
+    }
+    catch (PostgreSQL::Exception& exception)
+    {
+        ReportError("[Database] Cannot load list of servuses: %s",
+                exception.what());
+
+        throw exception;
+    }
 
-    return *servus;
+    return servuses;
 }
 
 unsigned long
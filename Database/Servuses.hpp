@@ -10,6 +10,8 @@
 
 // Local definition files.
 //
+#include "Primus/UUID.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Servus.hpp"
 
 namespace Database
@@ -20,15 +22,18 @@ namespace Database
         static unsigned long
         TotalNumber();
 
-        static Database::Servus&
-        ServusByAuthenticator(const std::string&);
+        static Database::Servus
+        ServusByAuthenticator(const Primus::UUID&);
 
-        static Database::Servus&
+        static Database::Servus
         ServusByIndex(const unsigned long);
 
-        static Database::Servus&
+        static Database::Servus
         ServusById(const unsigned long);
 
+        static Database::EntityList<Database::Servus>
+        AllServuses();
+
         static unsigned long
         DefineServus(const std::string& title);
 
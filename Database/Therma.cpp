@@ -30,22 +30,8 @@ Database::Therma::Therma(const unsigned long thermaId)
         query.execute(QuerySearchForDSSensorById);
 
         query.assertNumberOfRows(1);
-        query.assertNumberOfColumns(7);
-        query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
-        query.assertColumnOfType(1, PostgreSQL::INT8OID);
-        query.assertColumnOfType(2, PostgreSQL::UUIDOID);
-        query.assertColumnOfType(3, PostgreSQL::INT8OID);
-        query.assertColumnOfType(4, PostgreSQL::BPCHAROID);
-        query.assertColumnOfType(5, PostgreSQL::FLOAT4OID);
-        query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
-
-        this->timestamp         = query.popTIMESTAMP();
-        this->thermaId          = query.popBIGINT();
-        this->token             = query.popUUID();
-        this->servusId          = query.popBIGINT();
-        this->gpioDeviceNumber  = query.popCHAR();
-        this->temperatureEdge   = query.popREAL();
-        this->title             = query.popVARCHAR();
+
+        this->loadRow(query);
     }
     catch (PostgreSQL::OperatorIntervention& exception)
     {
@@ -62,12 +48,33 @@ Database::Therma::Therma(const unsigned long thermaId)
     }
 }
 
-Database::Therma::~Therma()
+/**
+ * @brief   Load DS18B20/DS18S20 sensor from current row of a query selecting the same columns as by id.
+ */
+Database::Therma::Therma(PostgreSQL::Query& query)
 {
-    if (this->timestamp != NULL)
-    {
-        delete this->timestamp;
-    }
+    this->loadRow(query);
+}
+
+void
+Database::Therma::loadRow(PostgreSQL::Query& query)
+{
+    query.assertNumberOfColumns(7);
+    query.assertColumnOfType(0, PostgreSQL::TIMESTAMPOID);
+    query.assertColumnOfType(1, PostgreSQL::INT8OID);
+    query.assertColumnOfType(2, PostgreSQL::UUIDOID);
+    query.assertColumnOfType(3, PostgreSQL::INT8OID);
+    query.assertColumnOfType(4, PostgreSQL::BPCHAROID);
+    query.assertColumnOfType(5, PostgreSQL::FLOAT4OID);
+    query.assertColumnOfType(6, PostgreSQL::VARCHAROID);
+
+    this->timestamp         = Primus::PopTimestamp(query);
+    this->thermaId          = query.popBIGINT();
+    this->token             = Primus::UUID::FromString(query.popUUID());
+    this->servusId          = query.popBIGINT();
+    this->gpioDeviceNumber  = query.popCHAR();
+    this->temperatureEdge   = query.popREAL();
+    this->title             = query.popVARCHAR();
 }
 
 void
@@ -6,16 +6,21 @@
 
 // Common definition files.
 //
+#include "PostgreSQL/PostgreSQL.hpp"
 #include "Toolkit/Times.hpp"
 
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
 namespace Database
 {
     class Therma
     {
     public:
-        Toolkit::Timestamp* timestamp;
+        Toolkit::Timestamp  timestamp;
         unsigned long       thermaId;
-        std::string         token;
+        Primus::UUID        token;
         unsigned long       servusId;
         std::string         gpioDeviceNumber;
         float               temperatureEdge;
@@ -24,7 +29,7 @@ namespace Database
     public:
         Therma(const unsigned long thermaId);
 
-        ~Therma();
+        Therma(PostgreSQL::Query& query);
 
         void
         setTitle(const std::string&);
@@ -36,5 +41,9 @@ namespace Database
 
         std::string
         diagramAsJava();
+
+    private:
+        void
+        loadRow(PostgreSQL::Query& query);
     };
 };
@@ -12,6 +12,7 @@
 // Local definition files.
 //
 #include "Primus/Database/Database.hpp"
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Therma.hpp"
 #include "Primus/Database/Thermas.hpp"
 #include "Primus/Database/Queries/Therma.h"
@@ -54,7 +55,7 @@ Database::Thermas::TotalNumber()
     return numberOfThermas;
 }
 
-Database::Therma&
+Database::Therma
 Database::Thermas::SensorByIndex(const unsigned long sensorId)
 {
     unsigned long thermaId;
@@ -95,55 +96,35 @@ Database::Thermas::SensorByIndex(const unsigned long sensorId)
     return Database::Thermas::SensorById(thermaId);
 }
 
-Database::Therma&
+Database::Therma
 Database::Thermas::SensorById(const unsigned long sensorId)
 {
-    Database::Therma* therma = new Database::Therma(sensorId);
-
-    return *therma;
+    return Database::Therma(sensorId);
 }
 
-void
-Database::NoticeDSSensorTemperature(
-    Toolkit::Timestamp& originTimestamp,
-    const std::string&  sensorToken,
-    const double        stampAsReal,
-    const float         temperature)
+/**
+ * @brief   Load all DS18B20/DS18S20 sensors with one query, in the order they are listed.
+ */
+Database::EntityList<Database::Therma>
+Database::Thermas::AllSensors()
 {
+    Database::EntityList<Database::Therma> thermas;
+
     Primus::Database& database = Primus::Database::SharedInstance(Primus::Database::Sensors);
 
     try
     {
         std::unique_lock<std::mutex> queueLock { database.lock };
 
-        PostgreSQL::Transaction transaction(database.connection());
+        PostgreSQL::Query query(database.connection());
+
+        query.execute(QueryAllDSSensors);
 
+        while (query.reachedLastRow() == false)
         {
-            PostgreSQL::Query query(database.connection());
-
-            union
-            {
-                unsigned long   stampInteger;
-                double          stampReal;
-            };
-
-            memcpy(&stampInteger, &stampAsReal, sizeof(stampAsReal));
-            stampInteger = htobe64(stampInteger);
-
-            union
-            {
-                unsigned int    temperatureInteger;
-                float           temperatureReal;
-            };
-
-            memcpy(&temperatureInteger, &temperature, sizeof(temperature));
-            temperatureInteger = htobe32(temperatureInteger);
-
-            query.pushTIMESTAMP(originTimestamp);
-            query.pushUUID(&sensorToken);
-            query.pushDOUBLE(&stampReal);
-            query.pushREAL(&temperatureReal);
-            query.execute(QueryInsertDSSensorTemperature);
+            thermas.emplace_back(query);
+
+            query.nextRow();
         }
     }
     catch (PostgreSQL::OperatorIntervention& exception)
@@ -154,9 +135,11 @@ Database::NoticeDSSensorTemperature(
     }
     catch (PostgreSQL::Exception& exception)
     {
-        ReportError("[Database] Cannot store DS18B20/DS18S20 sensor temperature: %s",
+        ReportError("[Database] Cannot load list of DS18B20/DS18S20 sensors: %s",
                 exception.what());
 
         throw exception;
     }
+
+    return thermas;
 }
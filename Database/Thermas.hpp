@@ -11,6 +11,7 @@
 
 // Local definition files.
 //
+#include "Primus/Database/EntityList.hpp"
 #include "Primus/Database/Therma.hpp"
 
 namespace Database
@@ -21,17 +22,13 @@ namespace Database
         static unsigned long
         TotalNumber();
 
-        static Database::Therma&
+        static Database::Therma
         SensorByIndex(const unsigned long);
 
-        static Database::Therma&
+        static Database::Therma
         SensorById(const unsigned long);
-    };
 
-    void
-    NoticeDSSensorTemperature(
-        Toolkit::Timestamp& originTimestamp,
-        const std::string&  sensorToken,
-        const double        stampAsReal,
-        const float         temperature);
+        static Database::EntityList<Database::Therma>
+        AllSensors();
+    };
 };
@@ -0,0 +1,137 @@
+// System definition files.
+//
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Dispatcher/Backpressure.hpp"
+
+static Dispatcher::Backpressure* instance = NULL;
+
+Dispatcher::Backpressure&
+Dispatcher::Backpressure::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[Backpressure] Already initialized");
+
+    instance = new Dispatcher::Backpressure();
+
+    return *instance;
+}
+
+Dispatcher::Backpressure&
+Dispatcher::Backpressure::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[Backpressure] Not initialized");
+
+    return *instance;
+}
+
+Dispatcher::Backpressure::Backpressure() :
+throttledFlag(false),
+queuedReadings(0),
+depositLatency(0),
+spoolBacklog(0),
+numberOfThrottlings(0)
+{ }
+
+/**
+ * @brief   Report load of ingest writer after a batch has been stored.
+ *
+ * @param   queuedReadings  Readings left in queue.
+ * @param   depositLatency  Milliseconds the oldest deposit of the batch has waited for commit.
+ */
+void
+Dispatcher::Backpressure::reportIngest(
+    const unsigned long queuedReadings,
+    const unsigned long depositLatency)
+{
+    std::unique_lock<std::mutex> backpressureLock { this->lock };
+
+    this->queuedReadings = queuedReadings;
+
+    // Latency is smoothed, so that a single slow commit does not throttle the fleet.
+    //
+    this->depositLatency = (this->depositLatency * 7 + depositLatency) / 8;
+
+    this->evaluate();
+}
+
+/**
+ * @brief   Report how much of spool is waiting for replay.
+ *
+ * @param   spoolBacklog    Bytes of spool file not replayed yet.
+ */
+void
+Dispatcher::Backpressure::reportSpool(const unsigned long spoolBacklog)
+{
+    std::unique_lock<std::mutex> backpressureLock { this->lock };
+
+    this->spoolBacklog = spoolBacklog;
+
+    this->evaluate();
+}
+
+Dispatcher::BackpressureStatistics
+Dispatcher::Backpressure::statistics()
+{
+    std::unique_lock<std::mutex> backpressureLock { this->lock };
+
+    Dispatcher::BackpressureStatistics statistics;
+
+    statistics.throttled = this->throttled();
+    statistics.queuedReadings = this->queuedReadings;
+    statistics.depositLatency = this->depositLatency;
+    statistics.spoolBacklog = this->spoolBacklog;
+    statistics.numberOfThrottlings = this->numberOfThrottlings;
+
+    return statistics;
+}
+
+/**
+ * @brief   Decide whether servuses have to be throttled.
+ *
+ * Must be called with lock held.
+ */
+void
+Dispatcher::Backpressure::evaluate()
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    if (this->throttled() == false)
+    {
+        if ((this->queuedReadings >= configuration.ingest.throttleQueuedReadings) ||
+            (this->depositLatency >= configuration.ingest.throttleDepositLatency) ||
+            (this->spoolBacklog >= configuration.ingest.throttleSpoolBacklog))
+        {
+            ReportWarning("[Backpressure] Throttling servuses: %lu readings queued, " \
+                    "%lu ms deposit latency, %lu bytes of spool backlog",
+                    this->queuedReadings,
+                    this->depositLatency,
+                    this->spoolBacklog);
+
+            this->numberOfThrottlings++;
+
+            this->throttledFlag.store(true, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        if ((this->queuedReadings < configuration.ingest.throttleQueuedReadings / 2) &&
+            (this->depositLatency < configuration.ingest.throttleDepositLatency / 2) &&
+            (this->spoolBacklog < configuration.ingest.throttleSpoolBacklog / 2))
+        {
+            ReportNotice("[Backpressure] Releasing servuses");
+
+            this->throttledFlag.store(false, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+// System definition files.
+//
+#include <atomic>
+#include <mutex>
+
+namespace Dispatcher
+{
+    struct BackpressureStatistics
+    {
+        bool            throttled;          /**< Whether servuses are asked to slow down. */
+        unsigned long   queuedReadings;     /**< Readings waiting for ingest writer. */
+        unsigned long   depositLatency;     /**< Smoothed milliseconds from deposit to commit. */
+        unsigned long   spoolBacklog;       /**< Bytes of spool waiting for replay. */
+        unsigned long   numberOfThrottlings;
+    };
+
+    /**
+     * Load of the ingest path as reported by ingest writer and spool drainer.
+     *
+     * Servuses are throttled once any measure crosses its threshold,
+     * and released once all of them have dropped below half of it,
+     * so that the fleet does not flap between both intervals.
+     */
+    class Backpressure
+    {
+    private:
+        std::atomic<bool> throttledFlag;
+
+        std::mutex lock;
+
+        unsigned long queuedReadings;
+        unsigned long depositLatency;
+        unsigned long spoolBacklog;
+        unsigned long numberOfThrottlings;
+
+    public:
+        static Dispatcher::Backpressure&
+        InitInstance();
+
+        static Dispatcher::Backpressure&
+        SharedInstance();
+
+        Backpressure();
+
+        bool
+        throttled() const
+        { return this->throttledFlag.load(std::memory_order_relaxed); }
+
+        void
+        reportIngest(
+            const unsigned long queuedReadings,
+            const unsigned long depositLatency);
+
+        void
+        reportSpool(const unsigned long spoolBacklog);
+
+        Dispatcher::BackpressureStatistics
+        statistics();
+
+    private:
+        void
+        evaluate();
+    };
+};
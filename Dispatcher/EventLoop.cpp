@@ -0,0 +1,571 @@
+// System definition files.
+//
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Database/Debug.hpp"
+#include "Primus/Dispatcher/EventLoop.hpp"
+#include "Primus/Dispatcher/Session.hpp"
+
+Dispatcher::EventLoop::EventLoop()
+{
+    this->epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (this->epollDescriptor < 0)
+    {
+        ReportSoftAlert("[Dispatcher] Cannot create epoll instance: errno=%d", errno);
+
+        throw std::runtime_error("[Dispatcher] Cannot create epoll instance");
+    }
+
+    this->wakeupDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (this->wakeupDescriptor < 0)
+    {
+        ReportSoftAlert("[Dispatcher] Cannot create event descriptor: errno=%d", errno);
+
+        close(this->epollDescriptor);
+
+        throw std::runtime_error("[Dispatcher] Cannot create event descriptor");
+    }
+
+    // Wakeup descriptor is the only one registered without session.
+    //
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+
+    epoll_ctl(this->epollDescriptor, EPOLL_CTL_ADD, this->wakeupDescriptor, &event);
+
+    this->thread = std::thread(&Dispatcher::EventLoop::ThreadHandler, this);
+}
+
+Dispatcher::EventLoop::~EventLoop()
+{
+    close(this->wakeupDescriptor);
+    close(this->epollDescriptor);
+}
+
+/**
+ * @brief   Pass a freshly accepted session over to event loop.
+ *
+ * Event loop takes ownership of the session. May be called from any thread.
+ *
+ * @param   session         Session to be adopted.
+ */
+void
+Dispatcher::EventLoop::adoptSession(Dispatcher::Session* session)
+{
+    {
+        std::unique_lock<std::mutex> mailboxLock { this->mailbox.lock };
+
+        this->mailbox.adopted.push_back(session);
+    }
+
+    this->wakeup();
+}
+
+/**
+ * @brief   Notify event loop that readings deposited by a session have been processed.
+ *
+ * Called from ingest writer thread.
+ *
+ * @param   session         Session which has deposited readings.
+ * @param   cseq            CSeq of request which has deposited readings.
+ * @param   avisoId         Aviso-Id of request to be confirmed.
+ * @param   committed       Whether readings have been committed to database.
+ */
+void
+Dispatcher::EventLoop::depositCompleted(
+    Dispatcher::Session*    session,
+    const unsigned int      cseq,
+    const unsigned int      avisoId,
+    const bool              committed)
+{
+    {
+        std::unique_lock<std::mutex> mailboxLock { this->mailbox.lock };
+
+        this->mailbox.completions.push_back({ session, cseq, avisoId, committed });
+    }
+
+    this->wakeup();
+}
+
+void
+Dispatcher::EventLoop::wakeup()
+{
+    const uint64_t increment = 1;
+
+    if (write(this->wakeupDescriptor, &increment, sizeof(increment)) < 0)
+    {
+        // Counter is already signalled - event loop will wake up anyway.
+    }
+}
+
+void
+Dispatcher::EventLoop::processMailbox()
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    uint64_t counter;
+
+    if (read(this->wakeupDescriptor, &counter, sizeof(counter)) < 0)
+    {
+        // Nothing signalled since last wakeup.
+    }
+
+    std::vector<Dispatcher::Session*> adopted;
+    std::vector<DepositCompletion> completions;
+
+    {
+        std::unique_lock<std::mutex> mailboxLock { this->mailbox.lock };
+
+        adopted.swap(this->mailbox.adopted);
+        completions.swap(this->mailbox.completions);
+    }
+
+    for (Dispatcher::Session* session : adopted)
+    {
+        ReportInfo("[Dispatcher] Event loop adopted session");
+
+        session->eventLoop = this;
+        session->debugSessionId = Primus::Debug::BeginServusSession(session->remoteAddress);
+
+        // Wait for the beginning of transmission (it should not explicitly begin immediately).
+        //
+        session->state = Dispatcher::AwaitingFirstDatagram;
+
+        this->timers.arm(session->timer,
+                configuration.servus.waitForFirstDatagram,
+                Dispatcher::FirstDatagramTimeout);
+
+        this->sessions.insert(session);
+
+        this->watchSession(session, true);
+    }
+
+    for (DepositCompletion& completion : completions)
+    {
+        if (this->sessions.count(completion.session) == 0)
+            continue;
+
+        completion.session->completeDeposit(
+                completion.cseq,
+                completion.avisoId,
+                completion.committed);
+
+        // Responses are sent only once all pipelined deposits are completed.
+        //
+        if (completion.session->pendingDeposits != 0)
+            continue;
+
+        this->watchSession(completion.session, true);
+
+        // Socket is watched again, so closing session must remove it from epoll.
+        //
+        completion.session->state = Dispatcher::AwaitingNextDatagram;
+
+        this->respond(completion.session);
+    }
+}
+
+/**
+ * @brief   Start or stop watching session socket for incoming data.
+ *
+ * Socket is removed from epoll while session waits for its deposits,
+ * so that neither data nor hangup are processed before response is sent.
+ *
+ * @param   session         Session to be watched.
+ * @param   readable        True to start watching, false to stop.
+ */
+void
+Dispatcher::EventLoop::watchSession(
+    Dispatcher::Session*    session,
+    const bool              readable)
+{
+    if (readable == true)
+    {
+        struct epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.ptr = session;
+
+        if (epoll_ctl(this->epollDescriptor, EPOLL_CTL_ADD, session->socket(), &event) < 0)
+        {
+            ReportError("[Dispatcher] Cannot watch session socket: errno=%d", errno);
+        }
+    }
+    else
+    {
+        epoll_ctl(this->epollDescriptor, EPOLL_CTL_DEL, session->socket(), NULL);
+    }
+}
+
+/**
+ * @brief   Switch watched session socket between incoming data and room for outgoing data.
+ *
+ * Hangup is not watched while waiting for room, otherwise half-closed connection
+ * with full send buffer would wake up event loop over and over.
+ *
+ * @param   session         Session being watched.
+ * @param   writable        True to watch for room to send, false for incoming data.
+ */
+void
+Dispatcher::EventLoop::rewatchSession(
+    Dispatcher::Session*    session,
+    const bool              writable)
+{
+    struct epoll_event event;
+    event.events = (writable == true) ? EPOLLOUT : (EPOLLIN | EPOLLRDHUP);
+    event.data.ptr = session;
+
+    if (epoll_ctl(this->epollDescriptor, EPOLL_CTL_MOD, session->socket(), &event) < 0)
+    {
+        ReportError("[Dispatcher] Cannot rewatch session socket: errno=%d", errno);
+    }
+}
+
+void
+Dispatcher::EventLoop::sessionReadable(Dispatcher::Session* session)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    const Dispatcher::ReceiveOutcome receiveOutcome = session->receiveChunk();
+
+    if (receiveOutcome == Dispatcher::ConnectionLost)
+    {
+        this->closeSession(session);
+
+        return;
+    }
+
+    if (receiveOutcome == Dispatcher::DatagramIncomplete)
+    {
+        // Wait until next chunk of datagram is available.
+        //
+        session->state = Dispatcher::AwaitingDatagramCompletion;
+
+        this->timers.arm(session->timer,
+                configuration.servus.waitForDatagramCompletion,
+                Dispatcher::DatagramCompletionTimeout);
+
+        return;
+    }
+
+    const Dispatcher::DatagramOutcome datagramOutcome = session->processDatagrams();
+
+    if (datagramOutcome == Dispatcher::ResponseDeferred)
+    {
+        this->watchSession(session, false);
+
+        // Sessions waiting for their deposits are not subject to timeout.
+        //
+        this->timers.disarm(session->timer);
+
+        session->state = Dispatcher::AwaitingDeposit;
+
+        return;
+    }
+
+    this->respond(session);
+}
+
+/**
+ * @brief   Send responses and prepare session for the next datagram.
+ *
+ * Responses socket does not accept at once are sent as soon as socket becomes writable,
+ * no further datagrams are read in the meantime.
+ *
+ * @param   session         Session with generated responses.
+ */
+void
+Dispatcher::EventLoop::respond(Dispatcher::Session* session)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    session->transmitResponses();
+
+    if (session->transmissionPending() == true)
+    {
+        this->rewatchSession(session, true);
+
+        session->state = Dispatcher::AwaitingTransmission;
+
+        this->timers.arm(session->timer,
+                configuration.servus.waitForDatagramCompletion,
+                Dispatcher::TransmissionTimeout);
+
+        return;
+    }
+
+    this->awaitDatagram(session);
+}
+
+/**
+ * @brief   Send the rest of responses once socket has room for them.
+ *
+ * @param   session         Session with pending responses.
+ */
+void
+Dispatcher::EventLoop::sessionWritable(Dispatcher::Session* session)
+{
+    session->transmitPending();
+
+    if (session->transmissionPending() == true)
+        return;
+
+    if (session->closing == false)
+    {
+        this->rewatchSession(session, false);
+    }
+
+    this->awaitDatagram(session);
+}
+
+/**
+ * @brief   Close session if it is closing, otherwise wait for the next datagram.
+ *
+ * @param   session         Session whose responses have been sent.
+ */
+void
+Dispatcher::EventLoop::awaitDatagram(Dispatcher::Session* session)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    if (session->closing == true)
+    {
+        this->closeSession(session);
+
+        return;
+    }
+
+    if (session->datagramPartiallyReceived() == true)
+    {
+        session->state = Dispatcher::AwaitingDatagramCompletion;
+
+        this->timers.arm(session->timer,
+                configuration.servus.waitForDatagramCompletion,
+                Dispatcher::DatagramCompletionTimeout);
+    }
+    else
+    {
+        session->state = Dispatcher::AwaitingNextDatagram;
+
+        this->timers.arm(session->timer,
+                session->intervalBetweenNeutrinos +
+                configuration.servus.finalWaitForNeutrino,
+                Dispatcher::KeepAliveTimeout);
+    }
+}
+
+/**
+ * @brief   Close all sessions whose timer has expired.
+ */
+void
+Dispatcher::EventLoop::expireSessions()
+{
+    std::vector<Dispatcher::Timer*> expired;
+
+    this->timers.advance(expired);
+
+    for (Dispatcher::Timer* timer : expired)
+    {
+        Dispatcher::Session* session = (Dispatcher::Session*) timer->owner;
+
+        switch (timer->reason)
+        {
+            case Dispatcher::FirstDatagramTimeout:
+                Primus::Debug::CommentServusSession(
+                        session->debugSessionId,
+                        "Poll for transmission timed out");
+                break;
+
+            case Dispatcher::DatagramCompletionTimeout:
+                Primus::Debug::CommentServusSession(
+                        session->debugSessionId,
+                        "Poll for chunk timed out");
+                break;
+
+            case Dispatcher::TransmissionTimeout:
+                Primus::Debug::CommentServusSession(
+                        session->debugSessionId,
+                        "Transmission timed out");
+                break;
+
+            default:
+                Primus::Debug::CommentServusSession(
+                        session->debugSessionId,
+                        "Session timed out");
+                break;
+        }
+
+        this->closeSession(session);
+    }
+}
+
+/**
+ * @brief   Get timer counts of event loop.
+ */
+Dispatcher::TimerStatistics
+Dispatcher::EventLoop::timerStatistics() const
+{
+    return this->timers.statistics();
+}
+
+void
+Dispatcher::EventLoop::closeSession(Dispatcher::Session* session)
+{
+    if (session->state != Dispatcher::AwaitingDeposit)
+    {
+        this->watchSession(session, false);
+    }
+
+    this->timers.disarm(session->timer);
+
+    this->sessions.erase(session);
+
+    session->finish();
+
+    ReportInfo("[Dispatcher] Event loop closed session");
+
+    delete session;
+}
+
+/**
+ * @brief   Thread handler for event loop.
+ */
+void
+Dispatcher::EventLoop::ThreadHandler(Dispatcher::EventLoop* eventLoop)
+{
+    ReportNotice("[Dispatcher] Event loop thread has been started");
+
+    struct epoll_event events[Dispatcher::EventsPerWait];
+
+    for (;;)
+    {
+        const int numberOfEvents = epoll_wait(
+                eventLoop->epollDescriptor,
+                events,
+                Dispatcher::EventsPerWait,
+                Dispatcher::EventLoopTick);
+
+        if (numberOfEvents < 0)
+        {
+            if (errno != EINTR)
+            {
+                ReportError("[Dispatcher] Event loop wait failed: errno=%d", errno);
+            }
+
+            continue;
+        }
+
+        for (int eventIndex = 0; eventIndex < numberOfEvents; eventIndex++)
+        {
+            Dispatcher::Session* session = (Dispatcher::Session*) events[eventIndex].data.ptr;
+
+            if (session == nullptr)
+            {
+                eventLoop->processMailbox();
+            }
+            else if (eventLoop->sessions.count(session) != 0)
+            {
+                if (session->state == Dispatcher::AwaitingTransmission)
+                {
+                    eventLoop->sessionWritable(session);
+                }
+                else
+                {
+                    eventLoop->sessionReadable(session);
+                }
+            }
+        }
+
+        eventLoop->expireSessions();
+    }
+
+    ReportWarning("[Dispatcher] Event loop thread is going to quit");
+}
+
+Dispatcher::EventLoops::EventLoops(const unsigned int numberOfEventLoops)
+{
+    for (unsigned int eventLoopIndex = 0;
+         eventLoopIndex < std::max(numberOfEventLoops, 1u);
+         eventLoopIndex++)
+    {
+        this->eventLoops.push_back(new Dispatcher::EventLoop());
+    }
+}
+
+/**
+ * @brief   Pass session accepted by an acceptor to one of the event loops of its share.
+ *
+ * Event loops are dealt out to acceptors in turn, every acceptor
+ * spreading its sessions over its own event loops round robin.
+ * If there are more acceptors than event loops, acceptors share event loops.
+ *
+ * @param   session             Accepted session.
+ * @param   acceptorIndex       Index of acceptor which has accepted the session.
+ * @param   numberOfAcceptors   Number of acceptors of the listener.
+ * @param   sessionNumber       Number of sessions accepted by the acceptor before.
+ */
+void
+Dispatcher::EventLoops::adoptSession(
+    Dispatcher::Session*    session,
+    const unsigned int      acceptorIndex,
+    const unsigned int      numberOfAcceptors,
+    const unsigned int      sessionNumber)
+{
+    const unsigned int numberOfEventLoops = this->eventLoops.size();
+
+    unsigned int eventLoopIndex;
+
+    if (numberOfAcceptors >= numberOfEventLoops)
+    {
+        eventLoopIndex = acceptorIndex % numberOfEventLoops;
+    }
+    else
+    {
+        const unsigned int shareSize =
+                (numberOfEventLoops - acceptorIndex + numberOfAcceptors - 1) / numberOfAcceptors;
+
+        eventLoopIndex = acceptorIndex + numberOfAcceptors * (sessionNumber % shareSize);
+    }
+
+    this->eventLoops[eventLoopIndex]->adoptSession(session);
+}
+
+/**
+ * @brief   Get timer counts summed over all event loops.
+ */
+Dispatcher::TimerStatistics
+Dispatcher::EventLoops::timerStatistics() const
+{
+    Dispatcher::TimerStatistics statistics = { };
+
+    for (const Dispatcher::EventLoop* eventLoop : this->eventLoops)
+    {
+        const Dispatcher::TimerStatistics timerStatistics = eventLoop->timerStatistics();
+
+        statistics.armed += timerStatistics.armed;
+
+        for (unsigned int reason = 0; reason < Dispatcher::NumberOfTimerReasons; reason++)
+        {
+            statistics.expirations[reason] += timerStatistics.expirations[reason];
+        }
+    }
+
+    return statistics;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+// System definition files.
+//
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Local definition files.
+//
+#include "Primus/Dispatcher/Session.hpp"
+#include "Primus/Dispatcher/TimerWheel.hpp"
+
+namespace Dispatcher
+{
+    static const unsigned int EventLoopTick             = 100;      /**< Milliseconds. */
+    static const unsigned int EventsPerWait             = 64;
+
+    /**
+     * Event loop multiplexing many servus sessions in one thread.
+     * Sockets are watched with epoll, timeouts are kept in a timer wheel advanced on every tick.
+     */
+    class EventLoop
+    {
+    private:
+        struct DepositCompletion
+        {
+            Dispatcher::Session*    session;
+            unsigned int            cseq;
+            unsigned int            avisoId;
+            bool                    committed;
+        };
+
+        /**
+         * Thread handler of event loop thread.
+         */
+        std::thread thread;
+
+        int epollDescriptor;
+        int wakeupDescriptor;
+
+        /**
+         * Sessions owned by event loop. Accessed only by event loop thread.
+         */
+        std::unordered_set<Dispatcher::Session*> sessions;
+
+        /**
+         * Timeouts of sessions. Accessed only by event loop thread.
+         */
+        Dispatcher::TimerWheel timers;
+
+        /**
+         * Sessions and deposit completions passed to event loop by other threads.
+         */
+        struct
+        {
+            std::mutex                          lock;
+            std::vector<Dispatcher::Session*>   adopted;
+            std::vector<DepositCompletion>      completions;
+        }
+        mailbox;
+
+    public:
+        EventLoop();
+
+        ~EventLoop();
+
+        void
+        adoptSession(Dispatcher::Session*);
+
+        void
+        depositCompleted(
+            Dispatcher::Session*    session,
+            const unsigned int      cseq,
+            const unsigned int      avisoId,
+            const bool              committed);
+
+        Dispatcher::TimerStatistics
+        timerStatistics() const;
+
+    private:
+        void
+        wakeup();
+
+        void
+        processMailbox();
+
+        void
+        watchSession(
+            Dispatcher::Session*    session,
+            const bool              readable);
+
+        void
+        rewatchSession(
+            Dispatcher::Session*    session,
+            const bool              writable);
+
+        void
+        sessionReadable(Dispatcher::Session*);
+
+        void
+        sessionWritable(Dispatcher::Session*);
+
+        void
+        respond(Dispatcher::Session*);
+
+        void
+        awaitDatagram(Dispatcher::Session*);
+
+        void
+        expireSessions();
+
+        void
+        closeSession(Dispatcher::Session*);
+
+        static void
+        ThreadHandler(Dispatcher::EventLoop*);
+    };
+
+    /**
+     * Set of event loops. New sessions are distributed round-robin.
+     */
+    class EventLoops
+    {
+    private:
+        std::vector<Dispatcher::EventLoop*> eventLoops;
+
+    public:
+        EventLoops(const unsigned int numberOfEventLoops);
+
+        void
+        adoptSession(
+            Dispatcher::Session*    session,
+            const unsigned int      acceptorIndex,
+            const unsigned int      numberOfAcceptors,
+            const unsigned int      sessionNumber);
+
+        Dispatcher::TimerStatistics
+        timerStatistics() const;
+    };
+};
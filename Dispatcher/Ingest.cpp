@@ -0,0 +1,417 @@
+// System definition files.
+//
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Common definition files.
+//
+#include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Report.h"
+#include "Toolkit/Times.hpp"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Database/Fabula.hpp"
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Dispatcher/Backpressure.hpp"
+#include "Primus/Dispatcher/Ingest.hpp"
+#include "Primus/Dispatcher/Notificator.hpp"
+
+static Dispatcher::Ingest* instance = NULL;
+
+Dispatcher::Ingest&
+Dispatcher::Ingest::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[Ingest] Already initialized");
+
+    instance = new Dispatcher::Ingest();
+
+    return *instance;
+}
+
+Dispatcher::Ingest&
+Dispatcher::Ingest::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[Ingest] Not initialized");
+
+    return *instance;
+}
+
+Dispatcher::Ingest::Ingest()
+{
+    this->queue.numberOfReadings = 0;
+}
+
+void
+Dispatcher::Ingest::startService()
+{
+    this->thread = std::thread(&Dispatcher::Ingest::ThreadHandler, this);
+}
+
+/**
+ * @brief   Put readings into ingest queue.
+ *
+ * Readings of one deposit are always committed within the same batch.
+ * Completion handler is called from writer thread.
+ * Once the queue holds as many readings as configured, further deposits
+ * are declined, so that a slow or unavailable database does not let it grow without bound.
+ *
+ * @param   readings        Readings to be stored. Vector is emptied if they have been queued.
+ * @param   completion      Completion handler, not called if deposit is declined.
+ *
+ * @return  True if readings have been queued, false if queue is full.
+ */
+bool
+Dispatcher::Ingest::deposit(
+    std::vector<Database::Reading>&     readings,
+    Dispatcher::IngestCompletion        completion)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+    if ((this->queue.numberOfReadings != 0) &&
+        (this->queue.numberOfReadings + readings.size() > configuration.ingest.maximalQueuedReadings))
+    {
+        return false;
+    }
+
+    this->queue.deposits.emplace_back();
+
+    Deposit& deposit = this->queue.deposits.back();
+    deposit.readings.swap(readings);
+    deposit.completion = completion;
+    deposit.arrival = std::chrono::steady_clock::now();
+
+    this->queue.numberOfReadings += deposit.readings.size();
+
+    this->queue.condition.notify_one();
+
+    return true;
+}
+
+/**
+ * @brief   Put readings into ingest queue and wait until the batch they belong to is committed.
+ *
+ * @param   readings        Readings to be stored. Vector is emptied.
+ *
+ * @throw   Dispatcher::IngestRejected  In case readings could not be stored.
+ */
+void
+Dispatcher::Ingest::depositAndWait(std::vector<Database::Reading>& readings)
+{
+    std::promise<bool> committed;
+
+    std::future<bool> result = committed.get_future();
+
+    const bool queued = this->deposit(readings,
+            [&committed](bool success)
+            {
+                committed.set_value(success);
+            });
+
+    if (queued == false)
+        throw Dispatcher::IngestRejected("Ingest queue is full");
+
+    if (result.get() == false)
+        throw Dispatcher::IngestRejected("Readings have not been stored");
+}
+
+/**
+ * @brief   Put aviso into ingest queue, so that fabula is created by writer thread.
+ *
+ * Completion handler is called from writer thread.
+ *
+ * @return  True if aviso has been queued, false if queue is full.
+ */
+bool
+Dispatcher::Ingest::depositAviso(
+    const std::string&                  originStamp,
+    const unsigned long                 servusId,
+    const std::string&                  originatorLabel,
+    const unsigned short                severityLevel,
+    const std::string&                  message,
+    Dispatcher::IngestCompletion        completion)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+    if (this->queue.avisos.size() >= configuration.ingest.maximalQueuedAvisos)
+        return false;
+
+    this->queue.avisos.push_back(
+            AvisoDeposit { originStamp, servusId, originatorLabel, severityLevel, message, completion });
+
+    this->queue.condition.notify_one();
+
+    return true;
+}
+
+/**
+ * @brief   Wait for readings or avisos and take the next batch out of the queue.
+ *
+ * A batch is taken as soon as either the maximal batch size is reached
+ * or the oldest deposit has been waiting for the maximal batch delay.
+ * Avisos do not wait for the batch, all queued ones are taken at once.
+ *
+ * @param   batch           Vector to be filled with deposits.
+ * @param   avisos          Vector to be filled with avisos.
+ */
+void
+Dispatcher::Ingest::collectBatch(
+    std::vector<Deposit>&               batch,
+    std::vector<AvisoDeposit>&          avisos)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    Dispatcher::Backpressure& backpressure = Dispatcher::Backpressure::SharedInstance();
+
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+    // Idle writer keeps reporting, so that servuses get released once load has gone.
+    //
+    while ((this->queue.deposits.empty() == true) && (this->queue.avisos.empty() == true))
+    {
+        if (this->queue.condition.wait_for(queueLock, std::chrono::seconds { 1 }) ==
+                std::cv_status::timeout)
+            backpressure.reportIngest(0, 0);
+    }
+
+    if (this->queue.avisos.empty() == false)
+    {
+        avisos.swap(this->queue.avisos);
+
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point deadline =
+            this->queue.deposits.front().arrival +
+            std::chrono::milliseconds { configuration.ingest.maximalBatchDelay };
+
+    while (this->queue.numberOfReadings < configuration.ingest.maximalBatchSize)
+    {
+        if (this->queue.condition.wait_until(queueLock, deadline) == std::cv_status::timeout)
+            break;
+    }
+
+    unsigned long numberOfReadings = 0;
+
+    // Take at least one deposit, even if it alone exceeds maximal batch size.
+    //
+    while ((this->queue.deposits.empty() == false) &&
+           ((numberOfReadings == 0) ||
+            (numberOfReadings + this->queue.deposits.front().readings.size() <=
+                    configuration.ingest.maximalBatchSize)))
+    {
+        numberOfReadings += this->queue.deposits.front().readings.size();
+
+        batch.push_back(std::move(this->queue.deposits.front()));
+
+        this->queue.deposits.pop_front();
+    }
+
+    this->queue.numberOfReadings -= numberOfReadings;
+}
+
+/**
+ * @brief   Commit batch to database and complete its deposits.
+ *
+ * If database refuses the batch, then every deposit is retried separately,
+ * so that a single broken deposit does not cause rejection of the whole batch.
+ * If database is not available, then the whole batch is rejected at once -
+ * retrying deposits one by one would only multiply failing round trips.
+ *
+ * @param   batch           Deposits to be stored.
+ */
+void
+Dispatcher::Ingest::storeBatch(std::vector<Deposit>& batch)
+{
+    std::vector<Database::Reading> readings;
+
+    for (Deposit& deposit : batch)
+    {
+        readings.insert(readings.end(), deposit.readings.begin(), deposit.readings.end());
+    }
+
+    try
+    {
+        Database::NoticeSensorReadings(readings);
+
+        ReportDebug("[Ingest] Committed %lu readings of %lu deposits",
+                readings.size(),
+                batch.size());
+
+        for (Deposit& deposit : batch)
+        {
+            deposit.completion(true);
+        }
+
+        return;
+    }
+    catch (PostgreSQL::OperatorIntervention& exception)
+    {
+        ReportWarning("[Ingest] Database is not available, rejecting batch of %lu readings: %s",
+                readings.size(),
+                exception.what());
+
+        for (Deposit& deposit : batch)
+        {
+            deposit.completion(false);
+        }
+
+        return;
+    }
+    catch (std::exception& exception)
+    {
+        ReportWarning("[Ingest] Cannot commit batch of %lu readings: %s",
+                readings.size(),
+                exception.what());
+    }
+
+    bool databaseAvailable = (batch.size() > 1);
+
+    for (Deposit& deposit : batch)
+    {
+        bool committed = false;
+
+        if (databaseAvailable == true)
+        {
+            try
+            {
+                Database::NoticeSensorReadings(deposit.readings);
+
+                committed = true;
+            }
+            catch (PostgreSQL::OperatorIntervention&)
+            {
+                databaseAvailable = false;
+            }
+            catch (std::exception&)
+            { }
+        }
+
+        deposit.completion(committed);
+    }
+}
+
+/**
+ * @brief   Create fabulas of avisos and complete them.
+ *
+ * Avisos are stored one by one, as each of them is a fabula of its own.
+ * Once database is not available, the remaining avisos are rejected without trying.
+ *
+ * @param   avisos          Avisos to be stored.
+ */
+void
+Dispatcher::Ingest::storeAvisos(std::vector<AvisoDeposit>& avisos)
+{
+    Dispatcher::Notificator& notificator = Dispatcher::Notificator::SharedInstance();
+
+    bool databaseAvailable = true;
+    bool fabulaCreated = false;
+
+    for (AvisoDeposit& aviso : avisos)
+    {
+        bool committed = false;
+
+        if (databaseAvailable == true)
+        {
+            try
+            {
+                Toolkit::Timestamp timestamp(aviso.originStamp);
+
+                Database::Fabula::Enqueue(
+                        timestamp,
+                        aviso.servusId,
+                        aviso.originatorLabel,
+                        aviso.severityLevel,
+                        aviso.message);
+
+                committed = true;
+            }
+            catch (PostgreSQL::OperatorIntervention& exception)
+            {
+                ReportWarning("[Ingest] Database is not available, rejecting avisos: %s",
+                        exception.what());
+
+                databaseAvailable = false;
+            }
+            catch (std::exception& exception)
+            {
+                ReportWarning("[Ingest] Cannot store aviso: %s",
+                        exception.what());
+            }
+        }
+
+        fabulaCreated |= committed;
+
+        aviso.completion(committed);
+    }
+
+    if (fabulaCreated == true)
+        notificator.triggerProcessing();
+}
+
+/**
+ * @brief   Report how long the batch has waited for commit and how many readings are still queued.
+ *
+ * @param   batch           Deposits just stored.
+ */
+void
+Dispatcher::Ingest::reportLoad(const std::vector<Deposit>& batch)
+{
+    Dispatcher::Backpressure& backpressure = Dispatcher::Backpressure::SharedInstance();
+
+    const std::chrono::steady_clock::duration latency =
+            std::chrono::steady_clock::now() - batch.front().arrival;
+
+    unsigned long numberOfReadings;
+
+    {
+        std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+        numberOfReadings = this->queue.numberOfReadings;
+    }
+
+    backpressure.reportIngest(
+            numberOfReadings,
+            std::chrono::duration_cast<std::chrono::milliseconds>(latency).count());
+}
+
+/**
+ * @brief   Thread handler for writer.
+ */
+void
+Dispatcher::Ingest::ThreadHandler(Dispatcher::Ingest* ingest)
+{
+    ReportNotice("[Ingest] Writer thread has been started");
+
+    for (;;)
+    {
+        std::vector<Deposit> batch;
+        std::vector<AvisoDeposit> avisos;
+
+        ingest->collectBatch(batch, avisos);
+
+        if (avisos.empty() == false)
+            ingest->storeAvisos(avisos);
+
+        if (batch.empty() == false)
+        {
+            ingest->storeBatch(batch);
+
+            ingest->reportLoad(batch);
+        }
+    }
+
+    ReportWarning("[Ingest] Writer thread is going to quit");
+}
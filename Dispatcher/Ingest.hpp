@@ -0,0 +1,121 @@
+#pragma once
+
+// System definition files.
+//
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Local definition files.
+//
+#include "Primus/Database/Readings.hpp"
+
+namespace Dispatcher
+{
+    /**
+     * Completion handler of a deposit. Called by writer thread with true
+     * once readings or aviso are committed to database, or with false in case of error.
+     */
+    typedef std::function<void(bool)> IngestCompletion;
+
+    class Ingest
+    {
+    private:
+        struct Deposit
+        {
+            std::vector<Database::Reading>          readings;
+            Dispatcher::IngestCompletion            completion;
+            std::chrono::steady_clock::time_point   arrival;
+        };
+
+        struct AvisoDeposit
+        {
+            std::string                             originStamp;
+            unsigned long                           servusId;
+            std::string                             originatorLabel;
+            unsigned short                          severityLevel;
+            std::string                             message;
+            Dispatcher::IngestCompletion            completion;
+        };
+
+        /**
+         * Thread handler of writer thread.
+         */
+        std::thread thread;
+
+        struct
+        {
+            std::mutex              lock;
+            std::condition_variable condition;
+            std::deque<Deposit>     deposits;
+            unsigned long           numberOfReadings;
+
+            /**
+             * Avisos are not batched, they are stored as soon as writer is free.
+             */
+            std::vector<AvisoDeposit>   avisos;
+        }
+        queue;
+
+    public:
+        static Dispatcher::Ingest&
+        InitInstance();
+
+        static Dispatcher::Ingest&
+        SharedInstance();
+
+        Ingest();
+
+        void
+        startService();
+
+        bool
+        deposit(
+            std::vector<Database::Reading>&     readings,
+            Dispatcher::IngestCompletion        completion);
+
+        void
+        depositAndWait(std::vector<Database::Reading>& readings);
+
+        bool
+        depositAviso(
+            const std::string&                  originStamp,
+            const unsigned long                 servusId,
+            const std::string&                  originatorLabel,
+            const unsigned short                severityLevel,
+            const std::string&                  message,
+            Dispatcher::IngestCompletion        completion);
+
+    private:
+        void
+        collectBatch(
+            std::vector<Deposit>&               batch,
+            std::vector<AvisoDeposit>&          avisos);
+
+        void
+        storeBatch(std::vector<Deposit>& batch);
+
+        void
+        storeAvisos(std::vector<AvisoDeposit>& avisos);
+
+        void
+        reportLoad(const std::vector<Deposit>& batch);
+
+        static void
+        ThreadHandler(Dispatcher::Ingest*);
+    };
+
+    class IngestRejected : public std::runtime_error
+    {
+    public:
+        IngestRejected(const char* const reason) throw() :
+        std::runtime_error(reason)
+        { }
+    };
+};
@@ -1,6 +1,8 @@
 // System definition files.
 //
+#include <algorithm>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 // Common definition files.
@@ -11,24 +13,83 @@
 
 // Local definition files.
 //
+#include "Primus/Dispatcher/EventLoop.hpp"
 #include "Primus/Dispatcher/Listener.hpp"
 #include "Primus/Dispatcher/Session.hpp"
 
 Dispatcher::Listener::Listener(
     const IP::Family        family,
-    const unsigned short    portNumber) :
-Inherited(family, "", portNumber)
+    const unsigned short    portNumber,
+    Dispatcher::EventLoops* eventLoops,
+    const unsigned int      numberOfAcceptors) :
+Inherited(family, portNumber),
+eventLoops(eventLoops)
 {
-    this->thread = std::thread(&Dispatcher::Listener::ThreadHandler, this);
+    for (unsigned int acceptorIndex = 0;
+         acceptorIndex < std::max(numberOfAcceptors, 1u);
+         acceptorIndex++)
+    {
+        this->threads.emplace_back(
+                &Dispatcher::Listener::ThreadHandler,
+                this,
+                acceptorIndex,
+                std::max(numberOfAcceptors, 1u));
+    }
+}
+
+/**
+ * @brief   Accept next session on the listening socket.
+ *
+ * @param   generation      Generation of socket the caller has been using.
+ *
+ * @return  Accepted session, or null if socket has been set up again
+ *          in the meantime and caller has to pick up its new generation.
+ */
+Dispatcher::Session*
+Dispatcher::Listener::acceptSession(const unsigned long generation)
+{
+    if (this->enterSocket(generation) == false)
+        return nullptr;
+
+    Dispatcher::Session* session;
+
+    try
+    {
+        session = new Dispatcher::Session { *this };
+    }
+    catch (...)
+    {
+        this->leaveSocket();
+
+        throw;
+    }
+
+    this->leaveSocket();
+
+    return session;
 }
 
 /**
- * @brief   Thread handler for service.
+ * @brief   Thread handler for acceptor.
+ *
+ * Every acceptor passes its sessions to its own share of event loops.
+ *
+ * @param   listener            Listener the acceptor belongs to.
+ * @param   acceptorIndex       Index of acceptor.
+ * @param   numberOfAcceptors   Number of acceptors of the listener.
  */
 void
-Dispatcher::Listener::ThreadHandler(Dispatcher::Listener* listener)
+Dispatcher::Listener::ThreadHandler(
+    Dispatcher::Listener*   listener,
+    const unsigned int      acceptorIndex,
+    const unsigned int      numberOfAcceptors)
 {
-    ReportNotice("[Dispatcher] Service thread has been started");
+    ReportNotice("[Dispatcher] Service thread %u has been started",
+            acceptorIndex);
+
+    unsigned long generation = 0;
+
+    unsigned int sessionNumber = 0;
 
     // Endless loop. In case an error on socket layer occurs,
     // the socket recovery will start automatically
@@ -38,12 +99,27 @@ Dispatcher::Listener::ThreadHandler(Dispatcher::Listener* listener)
     {
         try
         {
-            listener->disconnect();
-            listener->connect();
+            generation = listener->recover(generation);
 
             for (;;)
             {
-                Dispatcher::Session* session = new Dispatcher::Session { *listener };
+                Dispatcher::Session* session = listener->acceptSession(generation);
+
+                // Socket has been set up again by another acceptor.
+                //
+                if (session == nullptr)
+                    break;
+
+                if (listener->eventLoops != nullptr)
+                {
+                    listener->eventLoops->adoptSession(
+                            session,
+                            acceptorIndex,
+                            numberOfAcceptors,
+                            sessionNumber++);
+
+                    continue;
+                }
 
                 std::thread sessionThread
                 {
@@ -75,5 +151,6 @@ Dispatcher::Listener::ThreadHandler(Dispatcher::Listener* listener)
     //
     listener->disconnect();
 
-    ReportWarning("[Dispatcher] Service thread is going to quit");
+    ReportWarning("[Dispatcher] Service thread %u is going to quit",
+            acceptorIndex);
 }
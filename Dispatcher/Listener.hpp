@@ -3,32 +3,46 @@
 // System definition files.
 //
 #include <thread>
+#include <vector>
 
-// Common definition files.
+// Local definition files.
 //
-#include "Communicator/TCP.hpp"
+#include "Primus/SharedListener.hpp"
+#include "Primus/Dispatcher/EventLoop.hpp"
 
 namespace Dispatcher
 {
-    static const unsigned int BytesReceivePerStep = 64 * 1024;
-
-    class Listener : public TCP::Service
+    class Listener : public Primus::SharedListener
     {
-        typedef TCP::Service Inherited;
+        typedef Primus::SharedListener Inherited;
 
     private:
         /**
-         * Thread handler of service thread.
+         * Thread handlers of acceptor threads.
          */
-        std::thread thread;
+        std::vector<std::thread> threads;
+
+        /**
+         * Event loops to pass accepted sessions to,
+         * or null if every session runs in its own thread.
+         */
+        Dispatcher::EventLoops* eventLoops;
 
     public:
         Listener(
             const IP::Family        family,
-            const unsigned short    portNumber);
+            const unsigned short    portNumber,
+            Dispatcher::EventLoops* eventLoops,
+            const unsigned int      numberOfAcceptors);
 
     private:
+        Dispatcher::Session*
+        acceptSession(const unsigned long generation);
+
         static void
-        ThreadHandler(Dispatcher::Listener*);
+        ThreadHandler(
+            Dispatcher::Listener*   listener,
+            const unsigned int      acceptorIndex,
+            const unsigned int      numberOfAcceptors);
     };
 };
@@ -0,0 +1,655 @@
+// System definition files.
+//
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Common definition files.
+//
+#include "PostgreSQL/PostgreSQL.hpp"
+#include "RTSP/RTSP.hpp"
+#include "Toolkit/Report.h"
+#include "Toolkit/Times.hpp"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Statements.hpp"
+#include "Primus/UUID.hpp"
+#include "Primus/Database/Debug.hpp"
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Database/Servus.hpp"
+#include "Primus/Database/ServusCache.hpp"
+#include "Primus/Database/ServusConfigurations.hpp"
+#include "Primus/Database/Servuses.hpp"
+#include "Primus/Database/ServusPresence.hpp"
+#include "Primus/Dispatcher/Ingest.hpp"
+#include "Primus/Dispatcher/Retransmissions.hpp"
+#include "Primus/Dispatcher/Session.hpp"
+#include "Primus/Dispatcher/Spool.hpp"
+
+static const char*
+ParseReadings(
+    const Primus::StatementView&    payload,
+    std::vector<Database::Reading>& readings);
+
+static bool
+NextField(
+    const char*&                    cursor,
+    const char* const               end,
+    Primus::StatementView&          field);
+
+/**
+ * Methods known to dispatcher. Looked up once per datagram.
+ */
+static const std::unordered_map<std::string, Dispatcher::Method> Methods =
+{
+    { "AUTH",               { &Dispatcher::Session::handleAuth,             false } },
+    { "SETUP",              { &Dispatcher::Session::handleSetup,            true } },
+    { "PLAY",               { &Dispatcher::Session::handlePlay,             true } },
+    { "NEUTRINO",           { &Dispatcher::Session::handleNeutrino,         false } },
+    { "AVISO",              { &Dispatcher::Session::handleAviso,            true } },
+    { "DHT_HUMIDITY",       { &Dispatcher::Session::handleDHTHumidity,      true } },
+    { "DHT_TEMPERATURE",    { &Dispatcher::Session::handleDHTTemperature,   true } },
+    { "DS_TEMPERATURE",     { &Dispatcher::Session::handleDSTemperature,    true } },
+    { "READINGS",           { &Dispatcher::Session::handleReadings,         true } }
+};
+
+/**
+ * @brief   Find handler for request method and call it.
+ *
+ * @return  Outcome of the handler.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleDatagram()
+{
+    auto method = Methods.find(this->request.method());
+    if (method == Methods.end())
+        return this->handleUnknown();
+
+    if ((method->second.authenticationRequired == true) && (this->servus == nullptr))
+        return this->authenticationRequired();
+
+    return (this->*method->second.handler)();
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleAuth()
+{
+    Primus::StatementView authenticator { "", 0 };
+
+    this->statements.find("Authenticator", authenticator);
+
+    if (authenticator.length == 0)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response.generateResponse(RTSP::Unauthorized);
+
+        return this->rejectDatagram("Missing authenticator");
+    }
+
+    Primus::UUID authenticatorUUID;
+
+    if (authenticatorUUID.parse(authenticator.data, authenticator.length) == false)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response.generateResponse(RTSP::Unauthorized);
+
+        return this->rejectDatagram("Bad authenticator");
+    }
+
+    // Running-since statement is optional.
+    //
+    Primus::StatementView originStamp { "", 0 };
+    double stamp;
+
+    if ((this->statements.find("Running-Since", originStamp) == true) &&
+        (Primus::ParseStamp(originStamp, stamp) == false))
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Bad Running-Since";
+        this->response.generateResponse(RTSP::BadRequest);
+
+        return this->rejectDatagram("Bad 'Running-Since'");
+    }
+
+    if (this->servus != nullptr)
+    {
+        Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
+
+        presence.sessionClosed(this->servus->servusId);
+
+        this->servus.reset();
+    }
+
+    try
+    {
+        Database::ServusCache& servusCache = Database::ServusCache::SharedInstance();
+
+        this->servus = servusCache.servusByAuthenticator(authenticatorUUID);
+    }
+    catch (Database::ServusNotFound&)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response.generateResponse(RTSP::Unauthorized);
+
+        ReportInfo("[Dispatcher] Invalid authenticator provided: %.*s",
+                authenticator.length,
+                authenticator.data);
+
+        return this->rejectDatagram("Invalid authenticator");
+    }
+    catch (PostgreSQL::Exception&)
+    {
+        this->respondNotAcceptable();
+
+        return this->rejectDatagram("Cannot look up authenticator");
+    }
+
+    if (originStamp.length != 0)
+    {
+        try
+        {
+            Toolkit::Timestamp runningSince(originStamp.asString());
+
+            this->servus->setRunningSince(runningSince);
+        }
+        catch (PostgreSQL::Exception&)
+        {
+            // Running-since is informational only, servus is authenticated nevertheless.
+            //
+            ReportWarning("[Dispatcher] Cannot store running-since of servus \"%s\"",
+                    this->servus->title.c_str());
+        }
+    }
+
+    if (this->servus->enabled == false)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response.generateResponse(RTSP::Forbidden);
+
+        ReportInfo("[Dispatcher] Desabled servus tries to connect: %s",
+                this->servus->token.asString().c_str());
+
+        this->servus.reset();
+
+        return this->rejectDatagram("Servus disabled");
+    }
+
+    Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
+
+    presence.sessionOpened(this->servus->servusId, this->remoteAddress);
+
+    ReportInfo("[Dispatcher] Authentificated servus \"%s\"",
+            this->servus->title.c_str());
+
+    this->respondAuthenticated();
+
+    return Dispatcher::ResponseReady;
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleSetup()
+{
+    ReportInfo("[Dispatcher] Servus \"%s\" requested configuration",
+            this->servus->title.c_str());
+
+    try
+    {
+        Database::ServusConfigurations& servusConfigurations =
+                Database::ServusConfigurations::SharedInstance();
+
+        const Database::ServusConfigurationSnapshot servusConfiguration =
+                servusConfigurations.configurationOf(*this->servus);
+
+        // Servus may provide version of configuration it already has.
+        // If it is still up to date, then configuration itself is not sent again.
+        //
+        Primus::StatementView knownVersion { "", 0 };
+
+        this->statements.find("Configuration-Version", knownVersion);
+
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Neutrino-Interval"] = this->advertisedInterval();
+        this->response["Configuration-Version"] = servusConfiguration->version;
+
+        if ((knownVersion.length == servusConfiguration->version.length()) &&
+            (servusConfiguration->version.compare(0, knownVersion.length, knownVersion.data, knownVersion.length) == 0))
+        {
+            ReportInfo("[Dispatcher] Configuration of servus \"%s\" is not modified",
+                    this->servus->title.c_str());
+
+            this->response.generateResponse(RTSP::OK);
+        }
+        else
+        {
+            this->response.generateResponse(RTSP::OK, servusConfiguration->json);
+        }
+    }
+    catch (PostgreSQL::Exception&)
+    {
+        this->respondNotAcceptable();
+
+        return this->rejectDatagram("Bad servus configuration");
+    }
+
+    return Dispatcher::ResponseReady;
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handlePlay()
+{
+    ReportInfo("[Dispatcher] Servus \"%s\" started measurement",
+            this->servus->title.c_str());
+
+    this->respondResumed();
+
+    return Dispatcher::ResponseReady;
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleNeutrino()
+{
+    ReportDebug("[Dispatcher] Received neutrino");
+
+    this->respondResumed();
+
+    return Dispatcher::ResponseReady;
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleAviso()
+{
+    Dispatcher::Ingest& ingest = Dispatcher::Ingest::SharedInstance();
+
+    Dispatcher::Retransmissions& retransmissions = Dispatcher::Retransmissions::SharedInstance();
+
+    Dispatcher::Spool& spool = Dispatcher::Spool::SharedInstance();
+
+    ReportDebug("[Dispatcher] Received aviso");
+
+    try
+    {
+        unsigned int            avisoId;
+        Primus::StatementView   originStamp;
+        unsigned int            severity;
+        Primus::StatementView   originator;
+
+        if (this->statements.findUnsigned("Aviso-Id", avisoId) == false)
+            return this->declineDatagram("aviso", "Missing 'Aviso-Id'");
+
+        if ((this->statements.find("Timestamp", originStamp) == false) ||
+            (this->statements.findUnsigned("Severity", severity) == false))
+        {
+            return this->declineDatagram("aviso", "Missing 'Timestamp' or 'Severity'");
+        }
+
+        if ((this->statements.find("Originator", originator) == false) ||
+            (originator.empty() == true))
+        {
+            return this->declineDatagram("aviso", "Missing 'Originator'");
+        }
+
+        if (this->statements.payload().empty() == true)
+            return this->declineDatagram("aviso", "Missing payload");
+
+        // Aviso outlives the datagram, either in spool or in fabula queue.
+        //
+        const std::string payload = this->statements.payload().asString();
+
+        const Dispatcher::DepositKey key = { this->servus->servusId, avisoId, originStamp.asString() };
+
+        Dispatcher::IngestCompletion completion = this->depositCompletion(avisoId);
+
+        switch (retransmissions.admit(key, completion))
+        {
+            case Dispatcher::Retransmitted:
+            {
+                ReportInfo("[Dispatcher] Servus \"%s\" retransmitted aviso %u",
+                        this->servus->title.c_str(),
+                        avisoId);
+
+                this->respondCreated(avisoId);
+
+                return Dispatcher::ResponseReady;
+            }
+
+            case Dispatcher::RetransmissionPending:
+            {
+                this->pendingDeposits++;
+
+                return Dispatcher::ResponseDeferred;
+            }
+
+            default:
+                break;
+        }
+
+        // Created is sent once aviso is durable in spool, drainer creates fabula later.
+        // Without spool, fabula is created by ingest writer, so that session does not wait for database.
+        //
+        if (spool.enabled() == true)
+        {
+            spool.appendAviso(
+                    key.timestamp,
+                    this->servus->servusId,
+                    originator.asString(),
+                    (unsigned short) severity,
+                    payload,
+                    retransmissions.tracking(key, completion));
+        }
+        else if (ingest.depositAviso(
+                    key.timestamp,
+                    this->servus->servusId,
+                    originator.asString(),
+                    (unsigned short) severity,
+                    payload,
+                    retransmissions.tracking(key, completion)) == false)
+        {
+            return this->declineQueueFull(key, "aviso");
+        }
+
+        this->pendingDeposits++;
+
+        return Dispatcher::ResponseDeferred;
+    }
+    catch (std::exception& exception)
+    {
+        ReportError("[Dispatcher] Cannot process aviso: %s",
+                exception.what());
+
+        this->respondNotAcceptable();
+    }
+
+    return Dispatcher::ResponseReady;
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleDHTHumidity()
+{
+    ReportDebug("[Dispatcher] Received DHT11/DHT22 humidity");
+
+    return this->handleReading(Database::DHTHumidity, "Humidity", "DHT11/DHT22 humidity");
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleDHTTemperature()
+{
+    ReportDebug("[Dispatcher] Received DHT11/DHT22 temperature");
+
+    return this->handleReading(Database::DHTTemperature, "Temperature", "DHT11/DHT22 temperature");
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleDSTemperature()
+{
+    ReportDebug("[Dispatcher] Received DS18B20/DS18S20 temperature");
+
+    return this->handleReading(Database::DSTemperature, "Temperature", "DS18B20/DS18S20 temperature");
+}
+
+/**
+ * @brief   Deposit a single reading carried by statements of request.
+ *
+ * Statements are probed without exceptions, so that a malformed request
+ * costs no more than a good one.
+ *
+ * @param   kind            Kind of reading.
+ * @param   valueName       Name of statement carrying the value.
+ * @param   subject         Kind of reading as shown in log.
+ *
+ * @return  Whether response is ready or deferred.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleReading(
+    const Database::ReadingKind     kind,
+    const char* const               valueName,
+    const char* const               subject)
+{
+    unsigned int            avisoId;
+    Primus::StatementView   originStamp;
+    double                  stamp;
+    Primus::StatementView   sensorToken;
+    Primus::UUID            sensorUUID;
+    float                   value;
+
+    if (this->statements.findUnsigned("Aviso-Id", avisoId) == false)
+        return this->declineDatagram(subject, "Missing 'Aviso-Id'");
+
+    if ((this->statements.find("Timestamp", originStamp) == false) ||
+        (Primus::ParseStamp(originStamp, stamp) == false))
+    {
+        return this->declineDatagram(subject, "Missing or bad 'Timestamp'");
+    }
+
+    if ((this->statements.find("Sensor-Token", sensorToken) == false) ||
+        (sensorUUID.parse(sensorToken.data, sensorToken.length) == false))
+    {
+        return this->declineDatagram(subject, "Missing or bad 'Sensor-Token'");
+    }
+
+    if (this->statements.findFloat(valueName, value) == false)
+        return this->declineDatagram(subject, "Missing or bad value");
+
+    try
+    {
+        // Only timestamp and token are copied, as they travel with the reading.
+        //
+        std::vector<Database::Reading> readings;
+
+        readings.emplace_back(
+                kind,
+                originStamp.asString(),
+                stamp,
+                sensorUUID,
+                value);
+
+        // Created is only sent after the batch containing this reading is committed.
+        //
+        return this->depositReadings(readings, avisoId);
+    }
+    catch (std::exception& exception)
+    {
+        return this->declineDatagram(subject, exception.what());
+    }
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleReadings()
+{
+    ReportDebug("[Dispatcher] Received readings");
+
+    unsigned int avisoId;
+
+    if (this->statements.findUnsigned("Aviso-Id", avisoId) == false)
+        return this->declineDatagram("readings", "Missing 'Aviso-Id'");
+
+    try
+    {
+        std::vector<Database::Reading> readings;
+
+        const char* const malformation = ParseReadings(this->statements.payload(), readings);
+        if (malformation != NULL)
+            return this->declineDatagram("readings", malformation);
+
+        // All readings of the datagram are acknowledged with one response
+        // and stored within the same batch.
+        //
+        return this->depositReadings(readings, avisoId);
+    }
+    catch (std::exception& exception)
+    {
+        return this->declineDatagram("readings", exception.what());
+    }
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::handleUnknown()
+{
+    this->response.reset();
+    this->response["CSeq"] = this->expectedCSeq;
+    this->response["Agent"] = Primus::SoftwareVersion;
+    this->response.generateResponse(RTSP::MethodNotAllowed);
+
+    return this->rejectDatagram("Unknown method");
+}
+
+Dispatcher::DatagramOutcome
+Dispatcher::Session::authenticationRequired()
+{
+    ReportWarning("[Dispatcher] Servus calls %s before having authenticated itself",
+            this->request.method().c_str());
+
+    this->response.reset();
+    this->response["CSeq"] = this->expectedCSeq;
+    this->response["Agent"] = Primus::SoftwareVersion;
+    this->response["Reason"] = "Session not authenticated";
+    this->response.generateResponse(RTSP::Forbidden);
+
+    return this->rejectDatagram("Session not authenticated");
+}
+
+/**
+ * @brief   Parse payload of READINGS request.
+ *
+ * Payload carries one reading per line:
+ *
+ *     <kind> <sensor token> <timestamp> <value>
+ *
+ * where kind is one of DS_TEMPERATURE, DHT_TEMPERATURE or DHT_HUMIDITY,
+ * the same names as used for methods carrying a single reading.
+ * Empty lines are ignored. Payload is parsed in place,
+ * only timestamp and token of each reading are copied.
+ *
+ * @param   payload         Payload of request.
+ * @param   readings        Vector to be filled with parsed readings.
+ *
+ * @return  NULL if payload is fine, otherwise what is wrong with it.
+ */
+static const char*
+ParseReadings(
+    const Primus::StatementView&    payload,
+    std::vector<Database::Reading>& readings)
+{
+    const char* cursor = payload.data;
+    const char* const end = payload.data + payload.length;
+
+    while (cursor < end)
+    {
+        const char* lineEnd = (const char*) memchr(cursor, '\n', end - cursor);
+        if (lineEnd == NULL)
+            lineEnd = end;
+
+        Primus::StatementView kindName;
+        Primus::StatementView sensorToken;
+        Primus::StatementView originStamp;
+        Primus::StatementView valueText;
+
+        const bool lineEmpty = (NextField(cursor, lineEnd, kindName) == false);
+
+        if (lineEmpty == false)
+        {
+            if ((NextField(cursor, lineEnd, sensorToken) == false) ||
+                (NextField(cursor, lineEnd, originStamp) == false) ||
+                (NextField(cursor, lineEnd, valueText) == false))
+            {
+                return "Incomplete reading";
+            }
+
+            Database::ReadingKind kind;
+
+            if ((kindName.length == 14) && (memcmp(kindName.data, "DS_TEMPERATURE", 14) == 0))
+            {
+                kind = Database::DSTemperature;
+            }
+            else if ((kindName.length == 15) && (memcmp(kindName.data, "DHT_TEMPERATURE", 15) == 0))
+            {
+                kind = Database::DHTTemperature;
+            }
+            else if ((kindName.length == 12) && (memcmp(kindName.data, "DHT_HUMIDITY", 12) == 0))
+            {
+                kind = Database::DHTHumidity;
+            }
+            else
+            {
+                return "Unknown kind of reading";
+            }
+
+            Primus::UUID sensorUUID;
+            double stamp;
+            float value;
+
+            if (sensorUUID.parse(sensorToken.data, sensorToken.length) == false)
+                return "Bad sensor token of reading";
+
+            if (Primus::ParseStamp(originStamp, stamp) == false)
+                return "Bad timestamp of reading";
+
+            if (Primus::ParseFloat(valueText, value) == false)
+                return "Bad value of reading";
+
+            if (readings.size() == Primus::MaximalIngestBatchSize)
+                return "Too many readings";
+
+            readings.emplace_back(
+                    kind,
+                    originStamp.asString(),
+                    stamp,
+                    sensorUUID,
+                    value);
+        }
+
+        cursor = lineEnd + 1;
+    }
+
+    if (readings.empty() == true)
+        return "No readings";
+
+    return NULL;
+}
+
+/**
+ * @brief   Cut next whitespace-separated field off a line of payload.
+ *
+ * @param   cursor          Position within line, moved behind the field.
+ * @param   end             End of line.
+ * @param   field           View to be set to the field.
+ *
+ * @return  True if a field has been found, false if only whitespace is left.
+ */
+static bool
+NextField(
+    const char*&                    cursor,
+    const char* const               end,
+    Primus::StatementView&          field)
+{
+    while ((cursor < end) && (isspace((unsigned char) *cursor) != 0))
+        cursor++;
+
+    if (cursor == end)
+        return false;
+
+    const char* const begin = cursor;
+
+    while ((cursor < end) && (isspace((unsigned char) *cursor) == 0))
+        cursor++;
+
+    field = Primus::StatementView { begin, (unsigned int) (cursor - begin) };
+
+    return true;
+}
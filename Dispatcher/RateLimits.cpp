@@ -0,0 +1,227 @@
+// System definition files.
+//
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Database/Servus.hpp"
+#include "Primus/Dispatcher/RateLimits.hpp"
+
+static Dispatcher::RateLimits* instance = NULL;
+
+static void
+Refill(
+    Dispatcher::TokenBucket&                    bucket,
+    const unsigned int                          rate,
+    const unsigned int                          burst,
+    const std::chrono::steady_clock::time_point now);
+
+Dispatcher::RateLimits&
+Dispatcher::RateLimits::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[RateLimits] Already initialized");
+
+    instance = new Dispatcher::RateLimits();
+
+    return *instance;
+}
+
+Dispatcher::RateLimits&
+Dispatcher::RateLimits::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[RateLimits] Not initialized");
+
+    return *instance;
+}
+
+Dispatcher::RateLimits::RateLimits()
+{ }
+
+/**
+ * @brief   Take a token for a datagram from buckets of remote address and of servus.
+ *
+ * A token is taken only if both buckets have one, so that a datagram
+ * rejected by one bucket is not charged to the other.
+ *
+ * @param   remoteAddress   IP address datagram has been received from.
+ * @param   servus          Servus the session is authenticated as, or null.
+ *
+ * @return  True if datagram may be processed, false if it has to be rejected.
+ */
+bool
+Dispatcher::RateLimits::admit(
+    const std::string&          remoteAddress,
+    const Database::Servus*     servus)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    const unsigned int addressRate = configuration.servus.addressDatagramRate;
+    const unsigned int addressBurst = configuration.servus.addressDatagramBurst;
+    const unsigned int servusRate = configuration.servus.datagramRate;
+    const unsigned int servusBurst = configuration.servus.datagramBurst;
+
+    const bool addressLimited = (addressRate != 0);
+    const bool servusLimited = (servus != nullptr) && (servusRate != 0);
+
+    if ((addressLimited == false) && (servusLimited == false))
+        return true;
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> bucketsLock { this->lock };
+
+    Dispatcher::TokenBucket* addressBucket = nullptr;
+    Dispatcher::TokenBucket* servusBucket = nullptr;
+
+    if (addressLimited == true)
+    {
+        if ((this->addresses.size() >= Dispatcher::MaximalRateLimitedAddresses) &&
+            (this->addresses.find(remoteAddress) == this->addresses.end()))
+        {
+            this->sweepAddresses(now);
+        }
+
+        auto bucket = this->addresses.find(remoteAddress);
+        if (bucket == this->addresses.end())
+        {
+            bucket = this->addresses.emplace(
+                    remoteAddress,
+                    Dispatcher::TokenBucket { (double) addressBurst, now, 0 }).first;
+        }
+
+        addressBucket = &bucket->second;
+
+        Refill(*addressBucket, addressRate, addressBurst, now);
+
+        if (addressBucket->tokens < 1.0)
+        {
+            addressBucket->throttled++;
+
+            return false;
+        }
+    }
+
+    if (servusLimited == true)
+    {
+        auto bucket = this->servuses.find(servus->servusId);
+        if (bucket == this->servuses.end())
+        {
+            bucket = this->servuses.emplace(
+                    servus->servusId,
+                    Dispatcher::TokenBucket { (double) servusBurst, now, 0 }).first;
+        }
+
+        servusBucket = &bucket->second;
+
+        Refill(*servusBucket, servusRate, servusBurst, now);
+
+        if (servusBucket->tokens < 1.0)
+        {
+            servusBucket->throttled++;
+
+            return false;
+        }
+    }
+
+    if (addressBucket != nullptr)
+        addressBucket->tokens -= 1.0;
+
+    if (servusBucket != nullptr)
+        servusBucket->tokens -= 1.0;
+
+    return true;
+}
+
+/**
+ * @brief   Get number of datagrams of a servus rejected for exceeding its limit.
+ */
+unsigned long
+Dispatcher::RateLimits::throttledByServus(const unsigned long servusId)
+{
+    std::unique_lock<std::mutex> bucketsLock { this->lock };
+
+    auto bucket = this->servuses.find(servusId);
+
+    return (bucket == this->servuses.end()) ? 0 : bucket->second.throttled;
+}
+
+/**
+ * @brief   Get number of datagrams from a remote address rejected for exceeding its limit.
+ */
+unsigned long
+Dispatcher::RateLimits::throttledByAddress(const std::string& remoteAddress)
+{
+    std::unique_lock<std::mutex> bucketsLock { this->lock };
+
+    auto bucket = this->addresses.find(remoteAddress);
+
+    return (bucket == this->addresses.end()) ? 0 : bucket->second.throttled;
+}
+
+/**
+ * @brief   Drop buckets of remote addresses which have refilled completely,
+ *          as they behave exactly like new ones.
+ *
+ * Their counts of throttled datagrams are lost.
+ * Must be called with lock held.
+ */
+void
+Dispatcher::RateLimits::sweepAddresses(const std::chrono::steady_clock::time_point now)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    const unsigned int addressRate = configuration.servus.addressDatagramRate;
+    const unsigned int addressBurst = configuration.servus.addressDatagramBurst;
+
+    const unsigned long numberOfAddresses = this->addresses.size();
+
+    auto bucket = this->addresses.begin();
+
+    while (bucket != this->addresses.end())
+    {
+        Refill(bucket->second, addressRate, addressBurst, now);
+
+        if (bucket->second.tokens >= addressBurst)
+        {
+            bucket = this->addresses.erase(bucket);
+        }
+        else
+        {
+            bucket++;
+        }
+    }
+
+    ReportDebug("[RateLimits] Swept %lu of %lu remote addresses",
+            numberOfAddresses - this->addresses.size(),
+            numberOfAddresses);
+}
+
+/**
+ * @brief   Add tokens accumulated since the last refill, up to the burst size.
+ *
+ * Burst is at least one datagram, otherwise a limited sender could never send anything.
+ */
+static void
+Refill(
+    Dispatcher::TokenBucket&                    bucket,
+    const unsigned int                          rate,
+    const unsigned int                          burst,
+    const std::chrono::steady_clock::time_point now)
+{
+    const std::chrono::duration<double> elapsed = now - bucket.refilled;
+
+    bucket.tokens = std::min((double) std::max(burst, 1U), bucket.tokens + elapsed.count() * rate);
+    bucket.refilled = now;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// System definition files.
+//
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Local definition files.
+//
+#include "Primus/Database/Servus.hpp"
+
+namespace Dispatcher
+{
+    /**
+     * Seconds a servus is asked to wait after a datagram has been rejected for exceeding its rate.
+     */
+    static const unsigned int RateLimitRetryAfter = 1;
+
+    /**
+     * Once this many remote addresses are tracked, buckets which have refilled completely are dropped.
+     */
+    static const unsigned int MaximalRateLimitedAddresses = 4096;
+
+    struct TokenBucket
+    {
+        double                                  tokens;
+        std::chrono::steady_clock::time_point   refilled;
+        unsigned long                           throttled;      /**< Datagrams rejected by this bucket. */
+    };
+
+    /**
+     * Token buckets limiting datagrams per remote address and per servus.
+     *
+     * Limits of remote addresses and of servuses are taken from configuration.
+     * A rate of zero means no limit.
+     * Datagrams exceeding a limit are rejected before any of them reaches the database.
+     */
+    class RateLimits
+    {
+    private:
+        std::mutex lock;
+
+        std::unordered_map<std::string, Dispatcher::TokenBucket>    addresses;
+        std::unordered_map<unsigned long, Dispatcher::TokenBucket>  servuses;
+
+    public:
+        static Dispatcher::RateLimits&
+        InitInstance();
+
+        static Dispatcher::RateLimits&
+        SharedInstance();
+
+        RateLimits();
+
+        bool
+        admit(
+            const std::string&          remoteAddress,
+            const Database::Servus*     servus);
+
+        unsigned long
+        throttledByServus(const unsigned long servusId);
+
+        unsigned long
+        throttledByAddress(const std::string& remoteAddress);
+
+    private:
+        void
+        sweepAddresses(const std::chrono::steady_clock::time_point now);
+    };
+};
@@ -0,0 +1,230 @@
+// System definition files.
+//
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Common definition files.
+//
+#include "RTSP/RTSP.hpp"
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Dispatcher/Backpressure.hpp"
+#include "Primus/Dispatcher/RateLimits.hpp"
+#include "Primus/Dispatcher/Responses.hpp"
+
+static Dispatcher::ResponseTemplates* instance = NULL;
+static Dispatcher::ResponseTemplates* throttledInstance = NULL;
+
+static void
+AppendDecimal(
+    std::string&        content,
+    const unsigned int  value);
+
+Dispatcher::ResponseTemplate::ResponseTemplate()
+{ }
+
+/**
+ * @brief   Cut a response rendered with sentinel values into fixed fragments.
+ *
+ * Template stays invalid if sentinels cannot be found unambiguously,
+ * in which case caller has to fall back to RTSP::Datagram.
+ *
+ * @param   rendered        Response generated with sentinels for CSeq and Aviso-Id.
+ */
+void
+Dispatcher::ResponseTemplate::capture(RTSP::Datagram& rendered)
+{
+    const std::string content(rendered.contentBuffer, rendered.contentLength);
+
+    std::string cseqSentinel;
+    std::string avisoIdSentinel;
+
+    AppendDecimal(cseqSentinel, Dispatcher::ResponseCSeqSentinel);
+    AppendDecimal(avisoIdSentinel, Dispatcher::ResponseAvisoIdSentinel);
+
+    std::vector<std::string> fragments;
+    std::vector<Dispatcher::ResponseSlot> slots;
+
+    std::string::size_type offset = 0;
+
+    for (;;)
+    {
+        const std::string::size_type cseqOffset = content.find(cseqSentinel, offset);
+        const std::string::size_type avisoIdOffset = content.find(avisoIdSentinel, offset);
+
+        if ((cseqOffset == std::string::npos) && (avisoIdOffset == std::string::npos))
+            break;
+
+        const bool cseqFirst = (cseqOffset < avisoIdOffset);
+
+        const std::string::size_type slotOffset = (cseqFirst == true) ? cseqOffset : avisoIdOffset;
+
+        fragments.push_back(content.substr(offset, slotOffset - offset));
+        slots.push_back((cseqFirst == true) ? Dispatcher::CSeqSlot : Dispatcher::AvisoIdSlot);
+
+        offset = slotOffset + cseqSentinel.length();
+    }
+
+    fragments.push_back(content.substr(offset));
+
+    unsigned int numberOfCSeqSlots = 0;
+
+    for (Dispatcher::ResponseSlot slot : slots)
+    {
+        if (slot == Dispatcher::CSeqSlot)
+            numberOfCSeqSlots++;
+    }
+
+    if (numberOfCSeqSlots != 1)
+    {
+        ReportWarning("[Dispatcher] Cannot capture response template");
+
+        return;
+    }
+
+    this->fragments.swap(fragments);
+    this->slots.swap(slots);
+}
+
+/**
+ * @brief   Render response into a buffer.
+ *
+ * Buffer is reused, so that no allocation is necessary once it has grown large enough.
+ *
+ * @param   content         Buffer to be filled with response.
+ * @param   cseq            Value of CSeq.
+ * @param   avisoId         Value of Aviso-Id, if template has one.
+ */
+void
+Dispatcher::ResponseTemplate::render(
+    std::string&        content,
+    const unsigned int  cseq,
+    const unsigned int  avisoId) const
+{
+    content.assign(this->fragments[0]);
+
+    for (std::vector<Dispatcher::ResponseSlot>::size_type slotIndex = 0;
+         slotIndex < this->slots.size();
+         slotIndex++)
+    {
+        AppendDecimal(content,
+                (this->slots[slotIndex] == Dispatcher::CSeqSlot) ? cseq : avisoId);
+
+        content.append(this->fragments[slotIndex + 1]);
+    }
+}
+
+Dispatcher::ResponseTemplates&
+Dispatcher::ResponseTemplates::InitInstance()
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    if (instance != NULL)
+        throw std::runtime_error("[Dispatcher] Response templates already initialized");
+
+    instance = new Dispatcher::ResponseTemplates(
+            configuration.servus.intervalBetweenNeutrinos,
+            0);
+
+    throttledInstance = new Dispatcher::ResponseTemplates(
+            configuration.servus.throttledIntervalBetweenNeutrinos,
+            configuration.servus.throttledIntervalBetweenNeutrinos / 1000);
+
+    return *instance;
+}
+
+/**
+ * @brief   Get templates matching current load of ingest path.
+ */
+Dispatcher::ResponseTemplates&
+Dispatcher::ResponseTemplates::SharedInstance()
+{
+    Dispatcher::Backpressure& backpressure = Dispatcher::Backpressure::SharedInstance();
+
+    if (instance == NULL)
+        throw std::runtime_error("[Dispatcher] Response templates not initialized");
+
+    return (backpressure.throttled() == true) ? *throttledInstance : *instance;
+}
+
+/**
+ * Statements are set in the same order as the handlers set them,
+ * so that rendered templates are byte-identical to the responses generated before.
+ */
+Dispatcher::ResponseTemplates::ResponseTemplates(
+    const unsigned int  intervalBetweenNeutrinos,
+    const unsigned int  retryAfter) :
+intervalBetweenNeutrinos(intervalBetweenNeutrinos),
+retryAfter(retryAfter)
+{
+    RTSP::Datagram response;
+
+    response.reset();
+    response["CSeq"] = Dispatcher::ResponseCSeqSentinel;
+    response["Agent"] = Primus::SoftwareVersion;
+    response["Neutrino-Interval"] = intervalBetweenNeutrinos;
+    response.generateResponse(RTSP::OK);
+
+    this->authenticated.capture(response);
+
+    response.reset();
+    response["CSeq"] = Dispatcher::ResponseCSeqSentinel;
+    response["Agent"] = Primus::SoftwareVersion;
+    response["Neutrino-Interval"] = intervalBetweenNeutrinos;
+    response.generateResponse(RTSP::Continue);
+
+    this->resumed.capture(response);
+
+    response.reset();
+    response["CSeq"] = Dispatcher::ResponseCSeqSentinel;
+    response["Agent"] = Primus::SoftwareVersion;
+    response["Aviso-Id"] = Dispatcher::ResponseAvisoIdSentinel;
+    response["Neutrino-Interval"] = intervalBetweenNeutrinos;
+    response.generateResponse(RTSP::Created);
+
+    this->created.capture(response);
+
+    response.reset();
+    response["CSeq"] = Dispatcher::ResponseCSeqSentinel;
+    response["Agent"] = Primus::SoftwareVersion;
+    response["Neutrino-Interval"] = intervalBetweenNeutrinos;
+    if (retryAfter != 0)
+        response["Retry-After"] = retryAfter;
+    response.generateResponse(RTSP::NotAcceptable);
+
+    this->notAcceptable.capture(response);
+
+    response.reset();
+    response["CSeq"] = Dispatcher::ResponseCSeqSentinel;
+    response["Agent"] = Primus::SoftwareVersion;
+    response["Reason"] = "Rate limit exceeded";
+    response["Retry-After"] = Dispatcher::RateLimitRetryAfter;
+    response.generateResponse(RTSP::NotAcceptable);
+
+    this->rateLimited.capture(response);
+}
+
+static void
+AppendDecimal(
+    std::string&        content,
+    const unsigned int  value)
+{
+    char digits[10];
+
+    unsigned int remainder = value;
+    unsigned int numberOfDigits = 0;
+
+    do
+    {
+        digits[sizeof(digits) - ++numberOfDigits] = '0' + remainder % 10;
+        remainder /= 10;
+    }
+    while (remainder != 0);
+
+    content.append(&digits[sizeof(digits) - numberOfDigits], numberOfDigits);
+}
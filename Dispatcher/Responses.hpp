@@ -0,0 +1,82 @@
+#pragma once
+
+// System definition files.
+//
+#include <string>
+#include <vector>
+
+// Common definition files.
+//
+#include "RTSP/RTSP.hpp"
+
+namespace Dispatcher
+{
+    /**
+     * Values used to find variable statements in a response rendered by RTSP::Datagram.
+     * They are long enough not to appear anywhere else in a response.
+     */
+    static const unsigned int ResponseCSeqSentinel      = 3999999991;
+    static const unsigned int ResponseAvisoIdSentinel   = 3999999992;
+
+    enum ResponseSlot
+    {
+        CSeqSlot,
+        AvisoIdSlot
+    };
+
+    /**
+     * Pre-rendered response. Fixed part is rendered once by RTSP::Datagram,
+     * so it is byte-identical to what RTSP::Datagram would produce;
+     * only CSeq and Aviso-Id are spliced in for every response.
+     */
+    class ResponseTemplate
+    {
+    private:
+        std::vector<std::string>                fragments;
+        std::vector<Dispatcher::ResponseSlot>   slots;
+
+    public:
+        ResponseTemplate();
+
+        void
+        capture(RTSP::Datagram& rendered);
+
+        bool
+        valid() const
+        { return this->fragments.empty() == false; }
+
+        void
+        render(
+            std::string&        content,
+            const unsigned int  cseq,
+            const unsigned int  avisoId = 0) const;
+    };
+
+    /**
+     * Templates of the most frequent dispatcher responses for one neutrino interval.
+     * A second set with a longer interval is used while servuses are throttled.
+     */
+    class ResponseTemplates
+    {
+    public:
+        unsigned int                    intervalBetweenNeutrinos;
+        unsigned int                    retryAfter;         /**< Seconds, zero if not throttled. */
+
+        Dispatcher::ResponseTemplate    authenticated;      /**< OK to AUTH. */
+        Dispatcher::ResponseTemplate    resumed;            /**< Continue to PLAY and NEUTRINO. */
+        Dispatcher::ResponseTemplate    created;            /**< Created with Aviso-Id. */
+        Dispatcher::ResponseTemplate    notAcceptable;      /**< NotAcceptable without Aviso-Id, with Retry-After if throttled. */
+        Dispatcher::ResponseTemplate    rateLimited;        /**< NotAcceptable to datagram exceeding a rate limit. */
+
+    public:
+        static Dispatcher::ResponseTemplates&
+        InitInstance();
+
+        static Dispatcher::ResponseTemplates&
+        SharedInstance();
+
+        ResponseTemplates(
+            const unsigned int  intervalBetweenNeutrinos,
+            const unsigned int  retryAfter);
+    };
+};
@@ -0,0 +1,189 @@
+// System definition files.
+//
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/Dispatcher/Ingest.hpp"
+#include "Primus/Dispatcher/Retransmissions.hpp"
+
+static Dispatcher::Retransmissions* instance = NULL;
+
+Dispatcher::Retransmissions&
+Dispatcher::Retransmissions::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[Retransmissions] Already initialized");
+
+    instance = new Dispatcher::Retransmissions();
+
+    return *instance;
+}
+
+Dispatcher::Retransmissions&
+Dispatcher::Retransmissions::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[Retransmissions] Not initialized");
+
+    return *instance;
+}
+
+Dispatcher::Retransmissions::Retransmissions() :
+absorbed(0)
+{
+    this->deposits.reserve(Dispatcher::RetransmissionWindowSize);
+}
+
+/**
+ * @brief   Find out whether a deposit has been seen before.
+ *
+ * @param   key             Identity of deposit.
+ * @param   completion      Called with outcome of the first transmission,
+ *                          in case it is still being stored.
+ *
+ * @return  How deposit has to be handled.
+ */
+Dispatcher::Admission
+Dispatcher::Retransmissions::admit(
+    const Dispatcher::DepositKey&   key,
+    Dispatcher::IngestCompletion    completion)
+{
+    std::unique_lock<std::mutex> depositsLock { this->lock };
+
+    auto deposit = this->deposits.find(key);
+
+    if (deposit == this->deposits.end())
+    {
+        this->deposits[key].committed = false;
+        this->order.push_back(key);
+
+        this->evict();
+
+        return Dispatcher::FirstTransmission;
+    }
+
+    this->absorbed++;
+
+    if (deposit->second.committed == true)
+        return Dispatcher::Retransmitted;
+
+    deposit->second.waiting.push_back(completion);
+
+    return Dispatcher::RetransmissionPending;
+}
+
+/**
+ * @brief   Report outcome of the first transmission of a deposit.
+ *
+ * Retransmissions waiting for the outcome are completed with it.
+ *
+ * @param   key             Identity of deposit.
+ * @param   committed       Whether deposit has been stored.
+ */
+void
+Dispatcher::Retransmissions::complete(
+    const Dispatcher::DepositKey&   key,
+    const bool                      committed)
+{
+    std::vector<Dispatcher::IngestCompletion> waiting;
+
+    {
+        std::unique_lock<std::mutex> depositsLock { this->lock };
+
+        auto deposit = this->deposits.find(key);
+        if (deposit == this->deposits.end())
+            return;
+
+        waiting.swap(deposit->second.waiting);
+
+        if (committed == true)
+        {
+            deposit->second.committed = true;
+        }
+        else
+        {
+            // Key stays in admission order and is skipped when it comes to eviction.
+            //
+            this->deposits.erase(deposit);
+        }
+    }
+
+    for (Dispatcher::IngestCompletion& completion : waiting)
+    {
+        completion(committed);
+    }
+}
+
+/**
+ * @brief   Wrap completion handler of the first transmission, so that its outcome is reported.
+ *
+ * @param   key             Identity of deposit.
+ * @param   completion      Completion handler of the first transmission.
+ *
+ * @return  Completion handler to be used for the deposit.
+ */
+Dispatcher::IngestCompletion
+Dispatcher::Retransmissions::tracking(
+    const Dispatcher::DepositKey&   key,
+    Dispatcher::IngestCompletion    completion)
+{
+    return [this, key, completion](bool committed)
+            {
+                this->complete(key, committed);
+
+                completion(committed);
+            };
+}
+
+Dispatcher::RetransmissionStatistics
+Dispatcher::Retransmissions::statistics()
+{
+    std::unique_lock<std::mutex> depositsLock { this->lock };
+
+    Dispatcher::RetransmissionStatistics statistics;
+
+    statistics.remembered = this->deposits.size();
+    statistics.absorbed = this->absorbed;
+
+    return statistics;
+}
+
+/**
+ * @brief   Forget oldest deposits beyond the window size.
+ *
+ * Deposits still being stored are kept, as retransmissions may be waiting for them.
+ * Must be called with lock held.
+ */
+void
+Dispatcher::Retransmissions::evict()
+{
+    std::deque<Dispatcher::DepositKey>::size_type numberOfKeys = this->order.size();
+
+    while ((this->order.size() > Dispatcher::RetransmissionWindowSize) && (numberOfKeys > 0))
+    {
+        Dispatcher::DepositKey key = std::move(this->order.front());
+
+        this->order.pop_front();
+
+        numberOfKeys--;
+
+        auto deposit = this->deposits.find(key);
+
+        if ((deposit != this->deposits.end()) && (deposit->second.committed == false))
+        {
+            this->order.push_back(std::move(key));
+        }
+        else if (deposit != this->deposits.end())
+        {
+            this->deposits.erase(deposit);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+// System definition files.
+//
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Local definition files.
+//
+#include "Primus/Dispatcher/Ingest.hpp"
+
+namespace Dispatcher
+{
+    /**
+     * Number of most recent deposits remembered to recognize retransmissions.
+     */
+    static const unsigned int RetransmissionWindowSize = 100000;
+
+    /**
+     * Identity of a deposit. Aviso-Id alone starts over when servus restarts,
+     * therefore timestamp of the deposit is part of the key.
+     */
+    struct DepositKey
+    {
+        unsigned long   servusId;
+        unsigned int    avisoId;
+        std::string     timestamp;
+
+        bool
+        operator==(const DepositKey& other) const
+        {
+            return (this->servusId == other.servusId) &&
+                    (this->avisoId == other.avisoId) &&
+                    (this->timestamp == other.timestamp);
+        }
+    };
+
+    struct DepositKeyHash
+    {
+        size_t
+        operator()(const DepositKey& key) const
+        {
+            return std::hash<std::string>()(key.timestamp) ^
+                    (std::hash<unsigned long>()(key.servusId) * 31) ^
+                    (std::hash<unsigned int>()(key.avisoId) * 131);
+        }
+    };
+
+    enum Admission
+    {
+        FirstTransmission,      /**< Deposit has to be stored, outcome reported by complete(). */
+        Retransmitted,          /**< Deposit has been stored already. */
+        RetransmissionPending   /**< Deposit is being stored, completion is called with its outcome. */
+    };
+
+    struct RetransmissionStatistics
+    {
+        unsigned long   remembered;         /**< Deposits currently remembered. */
+        unsigned long   absorbed;           /**< Retransmissions acknowledged without storing. */
+    };
+
+    /**
+     * Bounded window of recent deposits of all servuses.
+     *
+     * A deposit is remembered from its first transmission on. Retransmissions
+     * of a deposit already stored are acknowledged right away; those arriving while
+     * the first transmission is still being stored share its outcome.
+     * Deposits which could not be stored are forgotten, so that they can be retransmitted.
+     */
+    class Retransmissions
+    {
+    private:
+        struct Deposit
+        {
+            bool                                        committed;
+            std::vector<Dispatcher::IngestCompletion>   waiting;
+        };
+
+        std::mutex lock;
+
+        std::unordered_map<DepositKey, Deposit, DepositKeyHash> deposits;
+
+        /**
+         * Keys in order of admission, oldest first.
+         */
+        std::deque<DepositKey> order;
+
+        unsigned long absorbed;
+
+    public:
+        static Dispatcher::Retransmissions&
+        InitInstance();
+
+        static Dispatcher::Retransmissions&
+        SharedInstance();
+
+        Retransmissions();
+
+        Dispatcher::Admission
+        admit(
+            const Dispatcher::DepositKey&   key,
+            Dispatcher::IngestCompletion    completion);
+
+        void
+        complete(
+            const Dispatcher::DepositKey&   key,
+            const bool                      committed);
+
+        Dispatcher::IngestCompletion
+        tracking(
+            const Dispatcher::DepositKey&   key,
+            Dispatcher::IngestCompletion    completion);
+
+        Dispatcher::RetransmissionStatistics
+        statistics();
+
+    private:
+        void
+        evict();
+    };
+};
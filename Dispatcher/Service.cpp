@@ -9,7 +9,7 @@
 // Local definition files.
 //
 #include "Primus/Configuration.hpp"
-#include "Primus/Database/Servuses.hpp"
+#include "Primus/Dispatcher/EventLoop.hpp"
 #include "Primus/Dispatcher/Listener.hpp"
 #include "Primus/Dispatcher/Service.hpp"
 
@@ -37,18 +37,45 @@ Dispatcher::Service::SharedInstance()
 
 Dispatcher::Service::Service()
 {
-    // Before starting dispatcher reset online status of all Servuses in database.
-    // Online status could be left "online" since last runtime of Primus.
-    //
-    Database::Servuses::ResetAllServuses();
-
     Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
 
+    if (configuration.servus.engine == Primus::EventDriven)
+    {
+        this->eventLoops = new Dispatcher::EventLoops(configuration.servus.numberOfEventLoops);
+    }
+    else
+    {
+        this->eventLoops = nullptr;
+    }
+
     this->listenerIPv4 = new Dispatcher::Listener(
             IP::IPv4,
-            configuration.servus.portNumberIPv4);
+            configuration.servus.portNumberIPv4,
+            this->eventLoops,
+            configuration.servus.numberOfAcceptors);
 
     this->listenerIPv6 = new Dispatcher::Listener(
             IP::IPv6,
-            configuration.servus.portNumberIPv6);
+            configuration.servus.portNumberIPv6,
+            this->eventLoops,
+            configuration.servus.numberOfAcceptors);
+}
+
+/**
+ * @brief   Get timer counts of event loops.
+ *
+ * Sessions running in their own threads notice timeouts by polling,
+ * therefore all counts are zero unless dispatcher runs event loops.
+ */
+Dispatcher::TimerStatistics
+Dispatcher::Service::timerStatistics() const
+{
+    if (this->eventLoops == nullptr)
+    {
+        Dispatcher::TimerStatistics statistics = { };
+
+        return statistics;
+    }
+
+    return this->eventLoops->timerStatistics();
 }
@@ -2,6 +2,7 @@
 
 // Local definition files.
 //
+#include "Primus/Dispatcher/EventLoop.hpp"
 #include "Primus/Dispatcher/Listener.hpp"
 
 namespace Dispatcher
@@ -9,6 +10,7 @@ namespace Dispatcher
     class Service
     {
     private:
+        Dispatcher::EventLoops* eventLoops;
         Dispatcher::Listener* listenerIPv4;
         Dispatcher::Listener* listenerIPv6;
 
@@ -20,5 +22,8 @@ namespace Dispatcher
         SharedInstance();
 
         Service();
+
+        Dispatcher::TimerStatistics
+        timerStatistics() const;
     };
 };
@@ -1,9 +1,18 @@
 // System definition files.
 //
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <strings.h>
+#include <cerrno>
 #include <chrono>
 #include <cstdlib>
-#include <sstream>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 // Common definition files.
 //
@@ -15,40 +24,71 @@
 // Local definition files.
 //
 #include "Primus/Configuration.hpp"
+#include "Primus/ReceiveBuffers.hpp"
 #include "Primus/Database/Debug.hpp"
-#include "Primus/Database/DHTSensorList.hpp"
-#include "Primus/Database/Fabula.hpp"
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Database/SensorTokens.hpp"
 #include "Primus/Database/Servus.hpp"
-#include "Primus/Database/Servuses.hpp"
-#include "Primus/Database/Thermas.hpp"
+#include "Primus/Database/ServusPresence.hpp"
+#include "Primus/Dispatcher/EventLoop.hpp"
+#include "Primus/Dispatcher/Ingest.hpp"
 #include "Primus/Dispatcher/Listener.hpp"
-#include "Primus/Dispatcher/Notificator.hpp"
+#include "Primus/Dispatcher/RateLimits.hpp"
+#include "Primus/Dispatcher/Responses.hpp"
+#include "Primus/Dispatcher/Retransmissions.hpp"
 #include "Primus/Dispatcher/Session.hpp"
+#include "Primus/Dispatcher/Spool.hpp"
+
+/**
+ * Whether received data begins with a complete datagram.
+ */
+enum DatagramFraming
+{
+    DatagramFramingIncomplete,
+    DatagramFramingComplete,
+    DatagramFramingMalformed
+};
+
+static DatagramFraming
+DatagramLength(
+    const std::string&          data,
+    std::string::size_type&     length);
 
 Dispatcher::Session::Session(TCP::Service& service) :
 Inherited(service)
 {
-    // Allocate resources to be used for receive buffer.
-    //
-    this->receiveBuffer = (char*) malloc(Dispatcher::BytesReceivePerStep);
-    if (this->receiveBuffer == NULL)
-    {
-        ReportSoftAlert("[Dispatcher] Out of memory");
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
 
-        throw std::runtime_error("[Dispatcher] Out of memory");
-    }
+    // Receive buffer is taken from the pool only while receiving.
+    //
+    this->receiveBufferClass = Primus::SmallReceiveBuffer;
 
     this->servus = nullptr;
-}
 
-Dispatcher::Session::~Session()
-{
-    if (this->servus != nullptr)
-        delete this->servus;
+    // Session should begin with CSeq 1 incrementing for each new datagram.
+    // Any other value means that either servus had a problem or be interpreted as intrusion attack.
+    //
+    this->expectedCSeq = 1;
 
-    free(this->receiveBuffer);
+    this->debugSessionId = 0;
+
+    this->pendingDeposits = 0;
+    this->closing = false;
+
+    this->intervalBetweenNeutrinos = configuration.servus.intervalBetweenNeutrinos;
+
+    this->eventLoop = nullptr;
+    this->state = Dispatcher::AwaitingFirstDatagram;
+
+    Dispatcher::TimerWheel::InitTimer(this->timer, this);
+
+    this->responseFromTemplate = false;
+    this->responseCSeq = 0;
 }
 
+Dispatcher::Session::~Session()
+{ }
+
 void
 Dispatcher::Session::ThreadHandler(Dispatcher::Session* session)
 {
@@ -56,19 +96,7 @@ Dispatcher::Session::ThreadHandler(Dispatcher::Session* session)
 
     Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
 
-    Dispatcher::Notificator& notificator = Dispatcher::Notificator::SharedInstance();
-
-    unsigned long debugSessionId = Primus::Debug::BeginServusSession(session->remoteAddress);
-
-    bool sessionOK = true;
-
-    // Session should begin with CSeq 1 incrementing for each new datagram.
-    // Any other value means that either servus had a problem or be interpreted as intrusion attack.
-    //
-    unsigned int expectedCSeq = 1;
-
-    RTSP::Datagram request;
-    RTSP::Datagram response;
+    session->debugSessionId = Primus::Debug::BeginServusSession(session->remoteAddress);
 
     // Wait for the beginning of transmission (it should not explicitly begin immediately).
     // Cancel session in case of timeout.
@@ -82,7 +110,7 @@ Dispatcher::Session::ThreadHandler(Dispatcher::Session* session)
     catch (Communicator::PollError&)
     {
         Primus::Debug::CommentServusSession(
-                debugSessionId,
+                session->debugSessionId,
                 "Poll for transmission did break");
 
         goto out;
@@ -90,573 +118,1029 @@ Dispatcher::Session::ThreadHandler(Dispatcher::Session* session)
     catch (Communicator::PollTimeout&)
     {
         Primus::Debug::CommentServusSession(
-                debugSessionId,
+                session->debugSessionId,
                 "Poll for transmission timed out");
 
         goto out;
     }
 
     // Manage an endless loop of:
-    //   - Receive datagram - if necessary receive several chunks until datagram is complete.
-    //   - Process datagram.
-    //   - Generate response.
-    //   - Send response.
+    //   - Receive chunk - it may carry part of a datagram or several pipelined datagrams.
+    //   - Process all complete datagrams in CSeq order.
+    //   - Wait until readings deposited by them are committed.
+    //   - Send all responses at once.
     //   - Store debug informations.
     //   - Periodically send neutrinos to servus to make sure it is still alive.
     // Break the loop if session is timed out (no datagram exchange for a long time).
     //
-    do
+    for (;;)
     {
-        request.reset();
+        const Dispatcher::ReceiveOutcome outcome = session->receiveChunk();
 
-        // Receive datagram chunks continuously until either complete datagram
-        // is received or timeout ocures.
-        //
-        for (;;)
+        if (outcome == Dispatcher::ConnectionLost)
+            goto out;
+
+        if (outcome == Dispatcher::DatagramComplete)
         {
-            unsigned int receivedBytes;
+            if (session->processDatagrams() == Dispatcher::ResponseDeferred)
+                session->waitForDeposits();
+
+            session->transmitResponses();
+
+            if (session->closing == true)
+                break;
+        }
 
+        if (session->datagramPartiallyReceived() == true)
+        {
+            // Wait until next chunk of datagram is available.
+            // Cancel session in case of timeout.
+            //
             try
             {
-                receivedBytes = Communicator::Receive(
+                Communicator::Poll(
                         session->socket(),
-                        session->receiveBuffer,
-                        Dispatcher::BytesReceivePerStep);
+                        configuration.servus.waitForDatagramCompletion);
             }
-            catch (Communicator::TransmissionError& exception)
+            catch (Communicator::PollError&)
             {
-                ReportWarning("[Dispatcher] Connection is broken: errno=%d",
-                        exception.errorNumber);
-
                 Primus::Debug::CommentServusSession(
-                        debugSessionId,
-                        "Connection is broken");
+                        session->debugSessionId,
+                        "Poll for chunk did break");
 
                 goto out;
             }
-            catch (Communicator::NothingReceived&)
+            catch (Communicator::PollTimeout&)
             {
-                ReportDebug("[Dispatcher] Disconnected");
-
                 Primus::Debug::CommentServusSession(
-                        debugSessionId,
-                        "Disconnected");
-
-                goto out;
-            }
-
-            try
-            {
-                request.push(session->receiveBuffer, receivedBytes);
-            }
-            catch (std::exception& exception)
-            {
-                ReportWarning("[Dispatcher] Rejected: %s", exception.what());
+                        session->debugSessionId,
+                        "Poll for chunk timed out");
 
                 goto out;
             }
-
-            if (request.datagramComplete() == true)
-            {
-                break;
-            }
-
-            // Wait until next chunk of datagram is available.
+        }
+        else
+        {
+            // Wait until next datagram is available.
             // Cancel session in case of timeout.
+            // If polling breaks due to new data available, then just go further
+            // to the beginning of the loop.
             //
             try
             {
                 Communicator::Poll(
                         session->socket(),
-                        configuration.servus.waitForDatagramCompletion);
+                        session->intervalBetweenNeutrinos +
+                        configuration.servus.finalWaitForNeutrino);
             }
             catch (Communicator::PollError&)
             {
                 Primus::Debug::CommentServusSession(
-                        debugSessionId,
-                        "Poll for chunk did break");
+                        session->debugSessionId,
+                        "Keep-alive polling did break");
 
                 goto out;
             }
             catch (Communicator::PollTimeout&)
             {
                 Primus::Debug::CommentServusSession(
-                        debugSessionId,
-                        "Poll for chunk timed out");
+                        session->debugSessionId,
+                        "Session timed out");
 
                 goto out;
             }
         }
+    }
+
+out:
+    session->finish();
+
+    ReportInfo("[Dispatcher] Thread is going to quit");
+
+    delete session;
+}
+
+/**
+ * @brief   Receive next chunk of data from socket.
+ *
+ * Expected to be called only when socket is readable, so that receive does not block.
+ * Chunk may carry the rest of a datagram as well as any number of following datagrams.
+ *
+ * @return  Whether at least one datagram is complete or the connection is lost.
+ */
+Dispatcher::ReceiveOutcome
+Dispatcher::Session::receiveChunk()
+{
+    Primus::ReceiveBuffer receiveBuffer { this->receiveBufferClass };
+
+    unsigned int receivedBytes;
+
+    try
+    {
+        receivedBytes = Communicator::Receive(
+                this->socket(),
+                receiveBuffer.data,
+                receiveBuffer.size);
+    }
+    catch (Communicator::TransmissionError& exception)
+    {
+        ReportWarning("[Dispatcher] Connection is broken: errno=%d",
+                exception.errorNumber);
+
+        Primus::Debug::CommentServusSession(
+                this->debugSessionId,
+                "Connection is broken");
+
+        return Dispatcher::ConnectionLost;
+    }
+    catch (Communicator::NothingReceived&)
+    {
+        ReportDebug("[Dispatcher] Disconnected");
+
+        Primus::Debug::CommentServusSession(
+                this->debugSessionId,
+                "Disconnected");
+
+        return Dispatcher::ConnectionLost;
+    }
+
+    this->receivedData.append(receiveBuffer.data, receivedBytes);
+
+    if (this->receivedData.length() > Dispatcher::MaximalPendingInput)
+    {
+        ReportWarning("[Dispatcher] Rejected: too much data pending");
+
+        Primus::Debug::CommentServusSession(
+                this->debugSessionId,
+                "Too much data pending");
+
+        return Dispatcher::ConnectionLost;
+    }
+
+    std::string::size_type datagramLength;
+
+    const DatagramFraming framing = DatagramLength(this->receivedData, datagramLength);
+
+    if (framing == DatagramFramingMalformed)
+    {
+        ReportWarning("[Dispatcher] Rejected: bad Content-Length");
+
+        Primus::Debug::CommentServusSession(
+                this->debugSessionId,
+                "Bad Content-Length");
+
+        return Dispatcher::ConnectionLost;
+    }
+
+    if (framing == DatagramFramingComplete)
+    {
+        this->receiveBufferClass = Primus::SmallReceiveBuffer;
+
+        return Dispatcher::DatagramComplete;
+    }
+
+    // Buffer has been filled completely, so the rest of the datagram is likely to be large.
+    //
+    if (receivedBytes == receiveBuffer.size)
+    {
+        this->receiveBufferClass = Primus::LargeReceiveBuffer;
+    }
+
+    return Dispatcher::DatagramIncomplete;
+}
+
+/**
+ * @brief   Process all complete datagrams received so far.
+ *
+ * Datagrams are processed in the order they were sent, each of them has to carry
+ * the next CSeq. Their responses are queued, so that they can be sent together.
+ * Processing stops at the first rejected datagram.
+ *
+ * @return  Whether all responses are ready to be sent, whether some of them
+ *          are deferred until readings are committed, or whether session has to be closed.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::processDatagrams()
+{
+    std::string datagram;
+
+    while ((this->closing == false) && (this->extractDatagram(datagram) == true))
+    {
+        this->request.reset();
 
         try
         {
-            try
-            {
-                const unsigned int providedCSeq = request["CSeq"];
+            this->request.push(datagram.data(), datagram.length());
 
-                if (providedCSeq != expectedCSeq)
-                {
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Reason"] = "Unexpected CSeq";
-                    response.generateResponse(RTSP::BadRequest);
+            if (this->request.datagramComplete() == false)
+                throw std::runtime_error("Datagram is truncated");
 
-                    throw Dispatcher::RejectDatagram("Unexpected CSeq");
-                }
-            }
-            catch (RTSP::StatementNotFound& exception)
-            {
-                response.reset();
-                response["CSeq"] = expectedCSeq;
-                response["Agent"] = Primus::SoftwareVersion;
-                response["Reason"] = "Missing CSeq";
-                response.generateResponse(RTSP::BadRequest);
+            this->statements.index(this->request.contentBuffer, this->request.contentLength);
+        }
+        catch (std::exception& exception)
+        {
+            ReportWarning("[Dispatcher] Rejected: %s", exception.what());
 
-                throw Dispatcher::RejectDatagram("Missing CSeq");
-            }
+            Primus::Debug::CommentServusSession(this->debugSessionId, exception.what());
 
-            if (request.methodIs("AUTH") == true)
-            {
-                const std::string authenticator = request["Authenticator"];
-                if (authenticator.length() == 0)
-                {
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response.generateResponse(RTSP::Unauthorized);
+            this->closing = true;
 
-                    throw Dispatcher::RejectDatagram("Missing authenticator");
-                }
-                else if (authenticator.length() != PostgreSQL::UUIDPlainLength)
-                {
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response.generateResponse(RTSP::Unauthorized);
+            break;
+        }
 
-                    throw Dispatcher::RejectDatagram("Bad authenticator");
-                }
+        this->pendingResponses.push_back(Dispatcher::PendingResponse());
 
-                try
-                {
-                    session->servus = &Database::Servuses::ServusByAuthenticator(authenticator);
+        Dispatcher::PendingResponse& pending = this->pendingResponses.back();
 
-                    session->servus->setOnline();
-                }
-                catch (Database::ServusNotFound&)
-                {
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response.generateResponse(RTSP::Unauthorized);
+        pending.cseq = this->expectedCSeq;
+        pending.ready = false;
+        pending.request.swap(datagram);
 
-                    ReportInfo("[Dispatcher] Invalid authenticator provided: %s",
-                            authenticator.c_str());
+        const Dispatcher::DatagramOutcome outcome = this->processDatagram();
 
-                    throw Dispatcher::RejectDatagram("Invalid authenticator");
-                }
+        if (this->servus != nullptr)
+        {
+            Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
 
-                try
-                {
-                    const std::string* originStamp = request["Running-Since"];
+            presence.datagramReceived(this->servus->servusId);
+        }
 
-                    Toolkit::Timestamp runningSince(*originStamp);
+        if (outcome != Dispatcher::ResponseDeferred)
+        {
+            this->takeResponse(pending.response);
 
-                    session->servus->setRunningSince(runningSince);
-                }
-                catch (RTSP::StatementNotFound& exception)
-                {
-                    // Running-since statement is optional.
-                }
+            pending.ready = true;
+        }
 
-                if (session->servus->enabled == false)
-                {
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response.generateResponse(RTSP::Forbidden);
+        if (outcome == Dispatcher::ResponseReadyCloseSession)
+        {
+            this->closing = true;
+        }
 
-                    ReportInfo("[Dispatcher] Desabled servus tries to connect: %s",
-                            session->servus->token.c_str());
+        // CSeq for each new datagram should be incremented by one.
+        //
+        if (outcome != Dispatcher::ResponseReadyCSeqNotConsumed)
+            this->expectedCSeq++;
+    }
 
-                    throw Dispatcher::RejectDatagram("Servus disabled");
-                }
+    if (this->pendingDeposits != 0)
+        return Dispatcher::ResponseDeferred;
 
-                ReportInfo("[Dispatcher] Authentificated servus \"%s\"",
-                        session->servus->title.c_str());
+    return (this->closing == true)
+            ? Dispatcher::ResponseReadyCloseSession
+            : Dispatcher::ResponseReady;
+}
 
-                response.reset();
-                response["CSeq"] = expectedCSeq;
-                response["Agent"] = Primus::SoftwareVersion;
-                response["Neutrino-Interval"] =
-                        configuration.servus.intervalBetweenNeutrinos;
-                response.generateResponse(RTSP::OK);
-            }
-            else if (request.methodIs("SETUP") == true)
-            {
-                ReportInfo("[Dispatcher] Servus \"%s\" requested configuration",
-                        session->servus->title.c_str());
+/**
+ * @brief   Cut next complete datagram off the received data.
+ *
+ * @param   datagram        Buffer to be filled with datagram.
+ *
+ * @return  True if a complete datagram has been received, false otherwise.
+ */
+bool
+Dispatcher::Session::extractDatagram(std::string& datagram)
+{
+    std::string::size_type datagramLength;
 
-                try
-                {
-                    const std::string configurationAsJSON = session->servus->configurationAsJSON();
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::OK, configurationAsJSON);
-                }
-                catch (PostgreSQL::Exception&)
-                {
-                    throw Dispatcher::RejectDatagram("Bad servus configuration");
-                }
-            }
-            else if (request.methodIs("PLAY") == true)
-            {
-                ReportInfo("[Dispatcher] Servus \"%s\" started measurement",
-                        session->servus->title.c_str());
-
-                response.reset();
-                response["CSeq"] = expectedCSeq;
-                response["Agent"] = Primus::SoftwareVersion;
-                response["Neutrino-Interval"] =
-                        configuration.servus.intervalBetweenNeutrinos;
-                response.generateResponse(RTSP::Continue);
-            }
-            else if (request.methodIs("NEUTRINO") == true)
-            {
-                ReportDebug("[Dispatcher] Received neutrino");
-
-                response.reset();
-                response["CSeq"] = expectedCSeq;
-                response["Agent"] = Primus::SoftwareVersion;
-                response["Neutrino-Interval"] =
-                        configuration.servus.intervalBetweenNeutrinos;
-                response.generateResponse(RTSP::Continue);
-            }
-            else if (request.methodIs("AVISO") == true)
-            {
-                ReportDebug("[Dispatcher] Received aviso");
+    switch (DatagramLength(this->receivedData, datagramLength))
+    {
+        case DatagramFramingComplete:
+            break;
 
-                try
-                {
-                    unsigned int    avisoId;
-                    std::string*    originStamp;
-                    unsigned short  severity;
-                    std::string*    originator;
-
-                    try
-                    {
-                        avisoId = request["Aviso-Id"];
-                    }
-                    catch (RTSP::StatementNotFound& exception)
-                    {
-                        response.reset();
-                        response["CSeq"] = expectedCSeq;
-                        response["Agent"] = Primus::SoftwareVersion;
-                        response["Neutrino-Interval"] =
-                                configuration.servus.intervalBetweenNeutrinos;
-                        response.generateResponse(RTSP::NotAcceptable);
-
-                        throw Dispatcher::RejectDatagram("[Dispatcher] Missing 'Aviso-Id'");
-                    }
-
-                    try
-                    {
-                        originStamp = request["Timestamp"];
-                        severity = request["Severity"];
-                    }
-                    catch (RTSP::StatementNotFound& exception)
-                    {
-                        response.reset();
-                        response["CSeq"] = expectedCSeq;
-                        response["Agent"] = Primus::SoftwareVersion;
-                        response["Aviso-Id"] = avisoId;
-                        response["Neutrino-Interval"] =
-                                configuration.servus.intervalBetweenNeutrinos;
-                        response.generateResponse(RTSP::NotAcceptable);
-
-                        throw Dispatcher::RejectDatagram("[Dispatcher] Missing 'Timestamp' or 'Severity'");
-                    }
-
-                    try
-                    {
-                        originator = request["Originator"];
-
-                        if (originator->empty() == true)
-                        {
-                            response.reset();
-                            response["CSeq"] = expectedCSeq;
-                            response["Agent"] = Primus::SoftwareVersion;
-                            response["Aviso-Id"] = avisoId;
-                            response["Neutrino-Interval"] =
-                                    configuration.servus.intervalBetweenNeutrinos;
-                            response.generateResponse(RTSP::NotAcceptable);
-
-                            throw Dispatcher::RejectDatagram("[Dispatcher] Empty 'Originator'");
-                        }
-                    }
-                    catch (RTSP::StatementNotFound& exception)
-                    {
-                        response.reset();
-                        response["CSeq"] = expectedCSeq;
-                        response["Agent"] = Primus::SoftwareVersion;
-                        response["Aviso-Id"] = avisoId;
-                        response["Neutrino-Interval"] =
-                                configuration.servus.intervalBetweenNeutrinos;
-                        response.generateResponse(RTSP::NotAcceptable);
-
-                        throw Dispatcher::RejectDatagram("[Dispatcher] Missing 'Originator'");
-                    }
-
-                    if (request.payloadLength() == 0)
-                    {
-                        response.reset();
-                        response["CSeq"] = expectedCSeq;
-                        response["Agent"] = Primus::SoftwareVersion;
-                        response["Aviso-Id"] = avisoId;
-                        response["Neutrino-Interval"] =
-                                configuration.servus.intervalBetweenNeutrinos;
-                        response.generateResponse(RTSP::NotAcceptable);
-
-                        throw Dispatcher::RejectDatagram("[Dispatcher] Missing payload");
-                    }
-
-                    Toolkit::Timestamp timestamp(*originStamp);
-
-                    std::string payload = request.payload();
-
-                    Database::Fabula::Enqueue(
-                            timestamp,
-                            session->servus->servusId,
-                            *originator,
-                            severity,
-                            payload);
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Aviso-Id"] = avisoId;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::Created);
-
-                    notificator.triggerProcessing();
-                }
-                catch (std::exception& exception)
-                {
-                    ReportError("[Dispatcher] Cannot process aviso: %s",
-                            exception.what());
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::NotAcceptable);
-                }
-            }
-            else if (request.methodIs("DHT_HUMIDITY") == true)
-            {
-                ReportDebug("[Dispatcher] Received DHT11/DHT22 humidity");
+        case DatagramFramingMalformed:
+        {
+            ReportWarning("[Dispatcher] Rejected: bad Content-Length");
 
-                try
-                {
-                    const unsigned int avisoId      = request["Aviso-Id"];
-                    const std::string originStamp   = request["Timestamp"];
-                    const std::string sensorToken   = request["Sensor-Token"];
-                    const float humidity            = request["Humidity"];
-
-                    Toolkit::Timestamp timestamp(originStamp);
-
-                    Database::NoticeDHTSensorHumidity(
-                            timestamp,
-                            sensorToken,
-                            std::stod(originStamp),
-                            humidity);
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Aviso-Id"] = avisoId;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::Created);
-                }
-                catch (std::exception& exception)
-                {
-                    ReportError("[Dispatcher] Cannot process DHT11/DHT22 humidity: %s",
-                            exception.what());
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::NotAcceptable);
-                }
-            }
-            else if (request.methodIs("DHT_TEMPERATURE") == true)
-            {
-                ReportDebug("[Dispatcher] Received DHT11/DHT22 temperature");
+            Primus::Debug::CommentServusSession(
+                    this->debugSessionId,
+                    "Bad Content-Length");
 
-                try
-                {
-                    const unsigned int avisoId      = request["Aviso-Id"];
-                    const std::string originStamp   = request["Timestamp"];
-                    const std::string sensorToken   = request["Sensor-Token"];
-                    const float temperature         = request["Temperature"];
-
-                    Toolkit::Timestamp timestamp(originStamp);
-
-                    Database::NoticeDHTSensorTemperature(
-                            timestamp,
-                            sensorToken,
-                            std::stod(originStamp),
-                            temperature);
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Aviso-Id"] = avisoId;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::Created);
-                }
-                catch (std::exception& exception)
-                {
-                    ReportError("[Dispatcher] Cannot process DHT11/DHT22 temperature: %s",
-                            exception.what());
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::NotAcceptable);
-                }
-            }
-            else if (request.methodIs("DS_TEMPERATURE") == true)
-            {
-                ReportDebug("[Dispatcher] Received DS18B20/DS18S20 temperature");
+            this->closing = true;
+
+            return false;
+        }
+
+        default:
+            return false;
+    }
+
+    datagram.assign(this->receivedData, 0, datagramLength);
+
+    this->receivedData.erase(0, datagramLength);
+
+    return true;
+}
+
+/**
+ * @brief   Process complete request datagram and generate response.
+ *
+ * @return  Whether response is ready to be sent, or whether it will be generated
+ *          later by completeDeposit() once readings are committed.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::processDatagram()
+{
+    this->responseFromTemplate = false;
+    this->responseCSeq = this->expectedCSeq;
+
+    Primus::StatementView cseq;
+    unsigned int providedCSeq;
+
+    if (this->statements.find("CSeq", cseq) == false)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Missing CSeq";
+        this->response.generateResponse(RTSP::BadRequest);
+
+        return this->rejectDatagram("Missing CSeq");
+    }
+
+    if (Primus::ParseUnsigned(cseq, providedCSeq) == false)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Bad CSeq";
+        this->response.generateResponse(RTSP::BadRequest);
+
+        return this->rejectDatagram("Bad CSeq");
+    }
+
+    // Datagrams beyond the rate limit are answered without being looked at any further.
+    // Their CSeq is not consumed and session stays open, so that servus may retransmit them later.
+    //
+    Dispatcher::RateLimits& rateLimits = Dispatcher::RateLimits::SharedInstance();
+
+    if (rateLimits.admit(this->remoteAddress, this->servus.get()) == false)
+    {
+        this->responseCSeq = providedCSeq;
+
+        this->respondRateLimited();
+
+        return Dispatcher::ResponseReadyCSeqNotConsumed;
+    }
+
+    if (providedCSeq != this->expectedCSeq)
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->expectedCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Unexpected CSeq";
+        this->response.generateResponse(RTSP::BadRequest);
+
+        return this->rejectDatagram("Unexpected CSeq");
+    }
+
+    // Handlers answer bad input and database errors themselves. Anything else
+    // must not escape, as it would take down the event loop with all its sessions.
+    //
+    try
+    {
+        return this->handleDatagram();
+    }
+    catch (std::exception& exception)
+    {
+        this->responseFromTemplate = false;
+
+        this->respondNotAcceptable();
+
+        return this->rejectDatagram(exception.what());
+    }
+}
+
+/**
+ * @brief   Reject request whose response has been generated already and close session.
+ *
+ * @param   reason          Why request is rejected, for log and debug.
+ *
+ * @return  Outcome closing the session once response is sent.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::rejectDatagram(const char* const reason)
+{
+    ReportWarning("[Dispatcher] Rejected: %s", reason);
+
+    Primus::Debug::CommentServusSession(this->debugSessionId, reason);
+
+    return Dispatcher::ResponseReadyCloseSession;
+}
+
+/**
+ * @brief   Answer a request which cannot be processed with NotAcceptable, session stays open.
+ *
+ * @param   subject         What was to be processed, for log.
+ * @param   reason          Why it cannot be processed.
+ *
+ * @return  Outcome with response ready.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::declineDatagram(
+    const char* const   subject,
+    const char* const   reason)
+{
+    ReportError("[Dispatcher] Cannot process %s: %s",
+            subject,
+            reason);
+
+    this->respondNotAcceptable();
+
+    return Dispatcher::ResponseReady;
+}
+
+/**
+ * @brief   Hand readings over to ingest writer, or to spool if it is enabled.
+ *
+ * Readings of unknown sensors are dropped without touching the database.
+ * If no reading is left, the request is rejected.
+ * Retransmitted readings are acknowledged without being stored again.
+ * Response is deferred until the writer reports completion, so that readings
+ * of pipelined datagrams are deposited without waiting for each other.
+ *
+ * @param   readings        Readings to be stored. Vector is emptied.
+ * @param   avisoId         Aviso-Id of request to be confirmed.
+ *
+ * @return  Whether response is ready or deferred.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::depositReadings(
+    std::vector<Database::Reading>& readings,
+    const unsigned int              avisoId)
+{
+    Dispatcher::Ingest& ingest = Dispatcher::Ingest::SharedInstance();
+
+    Dispatcher::Retransmissions& retransmissions = Dispatcher::Retransmissions::SharedInstance();
+
+    Dispatcher::Spool& spool = Dispatcher::Spool::SharedInstance();
+
+    Database::SensorTokens& sensorTokens = Database::SensorTokens::SharedInstance();
+
+    std::vector<Database::Reading>::iterator reading = readings.begin();
+
+    while (reading != readings.end())
+    {
+        if (sensorTokens.resolve(reading->kind, reading->sensorToken, reading->sensorId) == true)
+        {
+            reading++;
+        }
+        else
+        {
+            ReportWarning("[Dispatcher] Reading for unknown sensor %s",
+                    reading->sensorToken.asString().c_str());
+
+            reading = readings.erase(reading);
+        }
+    }
+
+    if (readings.empty() == true)
+    {
+        this->respondNotAcceptable();
+
+        return Dispatcher::ResponseReady;
+    }
+
+    // Readings of a datagram are identified by timestamp of the first one.
+    //
+    const Dispatcher::DepositKey key = { this->servus->servusId, avisoId, readings.front().originStamp };
+
+    Dispatcher::IngestCompletion completion = this->depositCompletion(avisoId);
 
-                try
+    switch (retransmissions.admit(key, completion))
+    {
+        case Dispatcher::Retransmitted:
+        {
+            ReportInfo("[Dispatcher] Servus \"%s\" retransmitted readings %u",
+                    this->servus->title.c_str(),
+                    avisoId);
+
+            this->respondCreated(avisoId);
+
+            return Dispatcher::ResponseReady;
+        }
+
+        case Dispatcher::RetransmissionPending:
+        {
+            this->pendingDeposits++;
+
+            return Dispatcher::ResponseDeferred;
+        }
+
+        default:
+            break;
+    }
+
+    if (spool.enabled() == true)
+    {
+        spool.appendReadings(readings, retransmissions.tracking(key, completion));
+    }
+    else if (ingest.deposit(readings, retransmissions.tracking(key, completion)) == false)
+    {
+        return this->declineQueueFull(key, "readings");
+    }
+
+    this->pendingDeposits++;
+
+    return Dispatcher::ResponseDeferred;
+}
+
+/**
+ * @brief   Answer a deposit which does not fit into ingest queue.
+ *
+ * Servus is asked to retry later. CSeq is not consumed, so that it may
+ * retransmit the same datagram, and retransmission tracking forgets the deposit.
+ *
+ * @param   key             Identity of deposit.
+ * @param   subject         What was to be deposited, for log.
+ *
+ * @return  Outcome with response ready and CSeq not consumed.
+ */
+Dispatcher::DatagramOutcome
+Dispatcher::Session::declineQueueFull(
+    const Dispatcher::DepositKey&   key,
+    const char* const               subject)
+{
+    Dispatcher::Retransmissions& retransmissions = Dispatcher::Retransmissions::SharedInstance();
+
+    ReportWarning("[Dispatcher] Ingest queue is full, declined %s of servus \"%s\"",
+            subject,
+            this->servus->title.c_str());
+
+    retransmissions.complete(key, false);
+
+    this->respondRateLimited();
+
+    return Dispatcher::ResponseReadyCSeqNotConsumed;
+}
+
+/**
+ * @brief   Create completion handler for a deposit of the current request.
+ *
+ * Completion is passed to the event loop multiplexing the session,
+ * or to the session itself if it runs in its own thread.
+ *
+ * @param   avisoId         Aviso-Id of request to be confirmed.
+ */
+Dispatcher::IngestCompletion
+Dispatcher::Session::depositCompletion(const unsigned int avisoId)
+{
+    Dispatcher::EventLoop* eventLoop = this->eventLoop;
+    Dispatcher::Session* session = this;
+
+    const unsigned int cseq = this->expectedCSeq;
+
+    return [eventLoop, session, cseq, avisoId](bool committed)
+            {
+                if (eventLoop == nullptr)
                 {
-                    const unsigned int avisoId      = request["Aviso-Id"];
-                    const std::string originStamp   = request["Timestamp"];
-                    const std::string sensorToken   = request["Sensor-Token"];
-                    const float temperature         = request["Temperature"];
-
-                    Toolkit::Timestamp timestamp(originStamp);
-
-                    Database::NoticeDSSensorTemperature(
-                            timestamp,
-                            sensorToken,
-                            std::stod(originStamp),
-                            temperature);
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Aviso-Id"] = avisoId;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::Created);
+                    session->depositCompleted(cseq, avisoId, committed);
                 }
-                catch (std::exception& exception)
+                else
                 {
-                    ReportError("[Dispatcher] Cannot process DS18B20/DS18S20 temperature: %s",
-                            exception.what());
-
-                    response.reset();
-                    response["CSeq"] = expectedCSeq;
-                    response["Agent"] = Primus::SoftwareVersion;
-                    response["Neutrino-Interval"] =
-                            configuration.servus.intervalBetweenNeutrinos;
-                    response.generateResponse(RTSP::NotAcceptable);
+                    eventLoop->depositCompleted(session, cseq, avisoId, committed);
                 }
-            }
-            else
-            {
-                response.reset();
-                response["CSeq"] = expectedCSeq;
-                response["Agent"] = Primus::SoftwareVersion;
-                response.generateResponse(RTSP::MethodNotAllowed);
+            };
+}
+
+/**
+ * @brief   Notify session running in its own thread that its readings have been processed.
+ *
+ * Called from ingest writer thread.
+ *
+ * @param   cseq            CSeq of request which has deposited readings.
+ * @param   avisoId         Aviso-Id of request to be confirmed.
+ * @param   committed       Whether readings have been committed to database.
+ */
+void
+Dispatcher::Session::depositCompleted(
+    const unsigned int  cseq,
+    const unsigned int  avisoId,
+    const bool          committed)
+{
+    std::unique_lock<std::mutex> depositsLock { this->deposits.lock };
+
+    this->deposits.completions.push_back({ cseq, avisoId, committed });
+
+    this->deposits.condition.notify_one();
+}
+
+/**
+ * @brief   Block until readings of all processed datagrams have been committed.
+ *
+ * Used only by session running in its own thread.
+ */
+void
+Dispatcher::Session::waitForDeposits()
+{
+    while (this->pendingDeposits != 0)
+    {
+        std::vector<Dispatcher::DepositCompletion> completions;
 
-                throw Dispatcher::RejectDatagram("Unknown method");
-            }
-        }
-        catch (Dispatcher::RejectDatagram& exception)
         {
-            ReportWarning("[Dispatcher] Rejected: %s", exception.what());
+            std::unique_lock<std::mutex> depositsLock { this->deposits.lock };
 
-            Primus::Debug::CommentServusSession(debugSessionId, exception.what());
+            while (this->deposits.completions.empty() == true)
+                this->deposits.condition.wait(depositsLock);
 
-            sessionOK = false;
+            completions.swap(this->deposits.completions);
         }
 
-        try
+        for (Dispatcher::DepositCompletion& completion : completions)
         {
-            Communicator::Send(
-                    session->socket(),
-                    response.contentBuffer,
-                    response.contentLength);
+            this->completeDeposit(completion.cseq, completion.avisoId, completion.committed);
         }
-        catch (...)
-        { }
+    }
+}
 
-        Primus::Debug::ReportServusRTSP(debugSessionId, request, response);
+/**
+ * @brief   Generate response for readings handed over to ingest writer.
+ *
+ * @param   cseq            CSeq of request which has deposited readings.
+ * @param   avisoId         Aviso-Id of request to be confirmed.
+ * @param   committed       Whether readings have been committed to database.
+ */
+void
+Dispatcher::Session::completeDeposit(
+    const unsigned int  cseq,
+    const unsigned int  avisoId,
+    const bool          committed)
+{
+    this->responseFromTemplate = false;
+    this->responseCSeq = cseq;
 
-        if (sessionOK == false)
-            break;
+    if (committed == true)
+    {
+        this->respondCreated(avisoId);
+    }
+    else
+    {
+        this->respondNotAcceptable();
+    }
 
-        // Wait until next datagram is available.
-        // Cancel session in case of timeout.
-        // If polling breaks due to new data available, then just go further
-        // to the beginning of the loop.
-        //
-        try
-        {
-            Communicator::Poll(
-                    session->socket(),
-                    configuration.servus.intervalBetweenNeutrinos +
-                    configuration.servus.finalWaitForNeutrino);
-        }
-        catch (Communicator::PollError&)
+    for (Dispatcher::PendingResponse& pending : this->pendingResponses)
+    {
+        if ((pending.ready == false) && (pending.cseq == cseq))
         {
-            Primus::Debug::CommentServusSession(
-                    debugSessionId,
-                    "Keep-alive polling did break");
+            this->takeResponse(pending.response);
 
-            goto out;
+            pending.ready = true;
+
+            break;
         }
-        catch (Communicator::PollTimeout&)
+    }
+
+    this->pendingDeposits--;
+}
+
+/**
+ * @brief   Generate OK response to successful authentication.
+ */
+void
+Dispatcher::Session::respondAuthenticated()
+{
+    Dispatcher::ResponseTemplates& templates = Dispatcher::ResponseTemplates::SharedInstance();
+
+    this->intervalBetweenNeutrinos = templates.intervalBetweenNeutrinos;
+
+    if (templates.authenticated.valid() == true)
+    {
+        templates.authenticated.render(this->responseContent, this->responseCSeq);
+
+        this->responseFromTemplate = true;
+    }
+    else
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->responseCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Neutrino-Interval"] = templates.intervalBetweenNeutrinos;
+        this->response.generateResponse(RTSP::OK);
+    }
+}
+
+/**
+ * @brief   Get neutrino interval matching current load and remember it for keep-alive timeout.
+ *
+ * @return  Milliseconds to be put into Neutrino-Interval.
+ */
+unsigned int
+Dispatcher::Session::advertisedInterval()
+{
+    Dispatcher::ResponseTemplates& templates = Dispatcher::ResponseTemplates::SharedInstance();
+
+    this->intervalBetweenNeutrinos = templates.intervalBetweenNeutrinos;
+
+    return this->intervalBetweenNeutrinos;
+}
+
+/**
+ * @brief   Generate Continue response to PLAY and NEUTRINO.
+ */
+void
+Dispatcher::Session::respondResumed()
+{
+    Dispatcher::ResponseTemplates& templates = Dispatcher::ResponseTemplates::SharedInstance();
+
+    this->intervalBetweenNeutrinos = templates.intervalBetweenNeutrinos;
+
+    if (templates.resumed.valid() == true)
+    {
+        templates.resumed.render(this->responseContent, this->responseCSeq);
+
+        this->responseFromTemplate = true;
+    }
+    else
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->responseCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Neutrino-Interval"] = templates.intervalBetweenNeutrinos;
+        this->response.generateResponse(RTSP::Continue);
+    }
+}
+
+/**
+ * @brief   Generate Created response confirming an aviso or readings.
+ *
+ * @param   avisoId         Aviso-Id of request to be confirmed.
+ */
+void
+Dispatcher::Session::respondCreated(const unsigned int avisoId)
+{
+    Dispatcher::ResponseTemplates& templates = Dispatcher::ResponseTemplates::SharedInstance();
+
+    this->intervalBetweenNeutrinos = templates.intervalBetweenNeutrinos;
+
+    if (templates.created.valid() == true)
+    {
+        templates.created.render(this->responseContent, this->responseCSeq, avisoId);
+
+        this->responseFromTemplate = true;
+    }
+    else
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->responseCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Aviso-Id"] = avisoId;
+        this->response["Neutrino-Interval"] = templates.intervalBetweenNeutrinos;
+        this->response.generateResponse(RTSP::Created);
+    }
+}
+
+/**
+ * @brief   Generate NotAcceptable response to a request which could not be processed.
+ */
+void
+Dispatcher::Session::respondNotAcceptable()
+{
+    Dispatcher::ResponseTemplates& templates = Dispatcher::ResponseTemplates::SharedInstance();
+
+    this->intervalBetweenNeutrinos = templates.intervalBetweenNeutrinos;
+
+    if (templates.notAcceptable.valid() == true)
+    {
+        templates.notAcceptable.render(this->responseContent, this->responseCSeq);
+
+        this->responseFromTemplate = true;
+    }
+    else
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->responseCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Neutrino-Interval"] = templates.intervalBetweenNeutrinos;
+        if (templates.retryAfter != 0)
+            this->response["Retry-After"] = templates.retryAfter;
+        this->response.generateResponse(RTSP::NotAcceptable);
+    }
+}
+
+/**
+ * @brief   Generate NotAcceptable response to a datagram exceeding a rate limit.
+ */
+void
+Dispatcher::Session::respondRateLimited()
+{
+    Dispatcher::ResponseTemplates& templates = Dispatcher::ResponseTemplates::SharedInstance();
+
+    if (templates.rateLimited.valid() == true)
+    {
+        templates.rateLimited.render(this->responseContent, this->responseCSeq);
+
+        this->responseFromTemplate = true;
+    }
+    else
+    {
+        this->response.reset();
+        this->response["CSeq"] = this->responseCSeq;
+        this->response["Agent"] = Primus::SoftwareVersion;
+        this->response["Reason"] = "Rate limit exceeded";
+        this->response["Retry-After"] = Dispatcher::RateLimitRetryAfter;
+        this->response.generateResponse(RTSP::NotAcceptable);
+    }
+}
+
+/**
+ * @brief   Copy generated response into a buffer.
+ *
+ * @param   content         Buffer to be filled with response.
+ */
+void
+Dispatcher::Session::takeResponse(std::string& content)
+{
+    if (this->responseFromTemplate == true)
+    {
+        content.assign(this->responseContent);
+    }
+    else
+    {
+        content.assign(this->response.contentBuffer, this->response.contentLength);
+    }
+}
+
+/**
+ * @brief   Send all responses which are ready to servus and store debug informations.
+ *
+ * Responses are sent in CSeq order with a single send,
+ * a response still waiting for its deposit holds back all following ones.
+ * Session running in its own thread blocks until all of them are sent,
+ * session driven by an event loop keeps what socket did not accept in transmit buffer.
+ * Session is marked as closing if connection is broken.
+ */
+void
+Dispatcher::Session::transmitResponses()
+{
+    std::string::size_type numberOfPendingBytes = this->transmitBuffer.length();
+
+    while (this->pendingResponses.empty() == false)
+    {
+        Dispatcher::PendingResponse& pending = this->pendingResponses.front();
+
+        if (pending.ready == false)
+            break;
+
+        this->transmitBuffer.append(pending.response);
+
+        Primus::Debug::ReportServusRTSP(
+                this->debugSessionId,
+                pending.request,
+                pending.response);
+
+        this->pendingResponses.pop_front();
+    }
+
+    if (this->transmitBuffer.length() == numberOfPendingBytes)
+        return;
+
+    if (this->eventLoop != nullptr)
+    {
+        this->transmitPending();
+
+        return;
+    }
+
+    try
+    {
+        Communicator::Send(
+                this->socket(),
+                this->transmitBuffer.data(),
+                this->transmitBuffer.length());
+    }
+    catch (Communicator::TransmissionError& exception)
+    {
+        ReportWarning("[Dispatcher] Cannot send responses: errno=%d",
+                exception.errorNumber);
+
+        Primus::Debug::CommentServusSession(
+                this->debugSessionId,
+                "Cannot send responses");
+
+        this->closing = true;
+    }
+
+    this->transmitBuffer.clear();
+}
+
+/**
+ * @brief   Send as much of transmit buffer as socket accepts without blocking.
+ *
+ * Session is marked as closing if connection is broken.
+ */
+void
+Dispatcher::Session::transmitPending()
+{
+    while (this->transmitBuffer.empty() == false)
+    {
+        const ssize_t sentBytes = send(
+                this->socket(),
+                this->transmitBuffer.data(),
+                this->transmitBuffer.length(),
+                MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        if (sentBytes < 0)
         {
+            if (errno == EINTR)
+                continue;
+
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+                return;
+
+            ReportWarning("[Dispatcher] Cannot send responses: errno=%d", errno);
+
             Primus::Debug::CommentServusSession(
-                    debugSessionId,
-                    "Session timed out");
+                    this->debugSessionId,
+                    "Cannot send responses");
 
-            goto out;
+            this->transmitBuffer.clear();
+
+            this->closing = true;
+
+            return;
         }
 
-        // CSeq for each new datagram should be incremented by one.
-        //
-        expectedCSeq++;
+        this->transmitBuffer.erase(0, sentBytes);
     }
-    while (sessionOK == true);
+}
 
-out:
-    if (session->servus != nullptr)
+/**
+ * @brief   Mark servus offline and close debug session.
+ */
+void
+Dispatcher::Session::finish()
+{
+    if (this->servus != nullptr)
     {
-        session->servus->setOffline();
+        Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
+
+        presence.sessionClosed(this->servus->servusId);
     }
 
-    Primus::Debug::CloseServusSession(debugSessionId);
+    Primus::Debug::CloseServusSession(this->debugSessionId);
+}
 
-    ReportInfo("[Dispatcher] Thread is going to quit");
+/**
+ * @brief   Find out whether data begins with a complete datagram.
+ *
+ * Datagram consists of statements terminated by an empty line,
+ * followed by as many bytes of payload as given by Content-Length.
+ *
+ * Content-Length which is not a number or exceeds what a session may have pending
+ * makes the data malformed, as the datagram could never be completed.
+ *
+ * @param   data            Received data.
+ * @param   length          Length of the first datagram.
+ *
+ * @return  Whether first datagram has been received completely, not yet, or is malformed.
+ */
+static DatagramFraming
+DatagramLength(
+    const std::string&          data,
+    std::string::size_type&     length)
+{
+    static const char ContentLength[] = "Content-Length:";
 
-    delete session;
+    const std::string::size_type statementsEnd = data.find("\r\n\r\n");
+    if (statementsEnd == std::string::npos)
+        return DatagramFramingIncomplete;
+
+    unsigned long payloadLength = 0;
+
+    std::string::size_type lineBegin = 0;
+
+    while (lineBegin < statementsEnd)
+    {
+        const std::string::size_type lineEnd = data.find("\r\n", lineBegin);
+
+        if ((lineEnd - lineBegin > sizeof(ContentLength) - 1) &&
+            (strncasecmp(&data[lineBegin], ContentLength, sizeof(ContentLength) - 1) == 0))
+        {
+            const char* const value = &data[lineBegin + sizeof(ContentLength) - 1];
+            char* valueEnd;
+
+            errno = 0;
+
+            payloadLength = strtoul(value, &valueEnd, 10);
+
+            // Value has to be a plain number, strtoul would accept a sign.
+            //
+            if ((valueEnd == value) ||
+                (valueEnd > &data[lineEnd]) ||
+                (errno != 0) ||
+                (memchr(value, '-', valueEnd - value) != NULL) ||
+                (payloadLength > Dispatcher::MaximalPendingInput))
+            {
+                return DatagramFramingMalformed;
+            }
+        }
+
+        lineBegin = lineEnd + 2;
+    }
+
+    length = statementsEnd + 4 + payloadLength;
+
+    return (data.length() >= length)
+            ? DatagramFramingComplete
+            : DatagramFramingIncomplete;
 }
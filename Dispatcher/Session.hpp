@@ -2,25 +2,178 @@
 
 // System definition files.
 //
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 // Common definition files.
 //
 #include "Communicator/TCP.hpp"
+#include "RTSP/RTSP.hpp"
 
 // Local definition files.
 //
+#include "Primus/Database/Readings.hpp"
+#include "Primus/ReceiveBuffers.hpp"
+#include "Primus/Statements.hpp"
 #include "Primus/Database/Servus.hpp"
+#include "Primus/Database/ServusCache.hpp"
+#include "Primus/Dispatcher/Ingest.hpp"
+#include "Primus/Dispatcher/Retransmissions.hpp"
+#include "Primus/Dispatcher/TimerWheel.hpp"
 
 namespace Dispatcher
 {
+    class EventLoop;
+
+    /**
+     * Maximal number of received bytes not yet processed.
+     * Servus sending more without waiting for responses is rejected.
+     */
+    static const unsigned int MaximalPendingInput = 256 * 1024;
+
+    enum ReceiveOutcome
+    {
+        DatagramIncomplete,
+        DatagramComplete,
+        ConnectionLost
+    };
+
+    enum DatagramOutcome
+    {
+        ResponseReady,
+        ResponseReadyCloseSession,
+        ResponseReadyCSeqNotConsumed,   /**< Datagram may be retransmitted with the same CSeq. */
+        ResponseDeferred
+    };
+
+    /**
+     * States of a session driven by an event loop.
+     */
+    enum SessionState
+    {
+        AwaitingFirstDatagram,
+        AwaitingDatagramCompletion,
+        AwaitingNextDatagram,
+        AwaitingDeposit,
+        AwaitingTransmission
+    };
+
+    /**
+     * Response to a pipelined datagram. Responses are sent strictly in CSeq order,
+     * so a response which is ready waits for all preceding ones.
+     */
+    struct PendingResponse
+    {
+        unsigned int    cseq;
+        bool            ready;
+        std::string     request;
+        std::string     response;
+    };
+
+    struct DepositCompletion
+    {
+        unsigned int    cseq;
+        unsigned int    avisoId;
+        bool            committed;
+    };
+
+    class Session;
+
+    typedef Dispatcher::DatagramOutcome (Dispatcher::Session::*MethodHandler)();
+
+    /**
+     * Entry of method table - handler of a method and whether it may be called
+     * only after servus has authenticated itself.
+     */
+    struct Method
+    {
+        Dispatcher::MethodHandler   handler;
+        bool                        authenticationRequired;
+    };
+
     class Session : public TCP::Connection
     {
         typedef TCP::Connection Inherited;
 
     private:
-        char*               receiveBuffer;
-        Database::Servus*   servus;
+        Primus::ReceiveBufferClass  receiveBufferClass;
+
+        /**
+         * Response rendered from a template. Sent instead of response datagram
+         * if responseFromTemplate is set.
+         */
+        std::string         responseContent;
+        bool                responseFromTemplate;
+
+        /**
+         * CSeq put into response being generated.
+         */
+        unsigned int        responseCSeq;
+
+        /**
+         * Received bytes not yet cut into datagrams.
+         */
+        std::string         receivedData;
+
+        std::deque<Dispatcher::PendingResponse> pendingResponses;
+
+        /**
+         * Responses not yet accepted by socket of session driven by an event loop.
+         */
+        std::string                             transmitBuffer;
+
+        /**
+         * Deposit completions passed by ingest writer to session running in its own thread.
+         */
+        struct
+        {
+            std::mutex                                  lock;
+            std::condition_variable                     condition;
+            std::vector<Dispatcher::DepositCompletion>  completions;
+        }
+        deposits;
+
+    public:
+        Database::ServusSnapshot    servus;
+        RTSP::Datagram      request;
+        RTSP::Datagram      response;
+        unsigned int        expectedCSeq;
+        unsigned long       debugSessionId;
+
+        /**
+         * Statements of request, looked up in place.
+         */
+        Primus::Statements  statements;
+
+        /**
+         * Number of datagrams whose readings are not yet committed.
+         */
+        unsigned int        pendingDeposits;
+
+        /**
+         * Set once a datagram has been rejected. Datagrams received after it
+         * are ignored and session is closed as soon as pending responses are sent.
+         */
+        bool                closing;
+
+        /**
+         * Neutrino interval advertised in the last response,
+         * longer than the configured one while servuses are throttled.
+         */
+        unsigned int        intervalBetweenNeutrinos;
+
+        /**
+         * Event loop the session is multiplexed by,
+         * or null if session runs in its own thread.
+         */
+        Dispatcher::EventLoop*                  eventLoop;
+        Dispatcher::SessionState                state;
+        Dispatcher::Timer                       timer;
 
     public:
         Session(TCP::Service&);
@@ -29,17 +182,108 @@ namespace Dispatcher
 
         static void
         ThreadHandler(Dispatcher::Session*);
+
+        Dispatcher::ReceiveOutcome
+        receiveChunk();
+
+        Dispatcher::DatagramOutcome
+        processDatagrams();
+
+        Dispatcher::DatagramOutcome
+        processDatagram();
+
+        void
+        depositCompleted(
+            const unsigned int  cseq,
+            const unsigned int  avisoId,
+            const bool          committed);
+
+        void
+        waitForDeposits();
+
+        void
+        completeDeposit(
+            const unsigned int  cseq,
+            const unsigned int  avisoId,
+            const bool          committed);
+
+        void
+        transmitResponses();
+
+        void
+        transmitPending();
+
+        bool
+        transmissionPending() const
+        { return this->transmitBuffer.empty() == false; }
+
+        bool
+        datagramPartiallyReceived() const
+        { return this->receivedData.empty() == false; }
+
+        void
+        finish();
+
+        Dispatcher::DatagramOutcome
+        handleDatagram(),
+        handleAuth(),
+        handleSetup(),
+        handlePlay(),
+        handleNeutrino(),
+        handleAviso(),
+        handleDHTHumidity(),
+        handleDHTTemperature(),
+        handleDSTemperature(),
+        handleReadings(),
+        handleUnknown(),
+        authenticationRequired();
+
+        unsigned int
+        advertisedInterval();
+
+        void
+        respondAuthenticated(),
+        respondResumed(),
+        respondCreated(const unsigned int avisoId),
+        respondNotAcceptable(),
+        respondRateLimited();
+
+    private:
+        bool
+        extractDatagram(std::string& datagram);
+
+        Dispatcher::DatagramOutcome
+        rejectDatagram(const char* const reason);
+
+        Dispatcher::DatagramOutcome
+        declineDatagram(
+            const char* const   subject,
+            const char* const   reason);
+
+        Dispatcher::DatagramOutcome
+        declineQueueFull(
+            const Dispatcher::DepositKey&   key,
+            const char* const               subject);
+
+        Dispatcher::DatagramOutcome
+        handleReading(
+            const Database::ReadingKind     kind,
+            const char* const               valueName,
+            const char* const               subject);
+
+        void
+        takeResponse(std::string& content);
+
+        Dispatcher::DatagramOutcome
+        depositReadings(
+            std::vector<Database::Reading>& readings,
+            const unsigned int              avisoId);
+
+        Dispatcher::IngestCompletion
+        depositCompletion(const unsigned int avisoId);
     };
 
     void transformToken(char*, char* const);
 
     void xmit(char*);
-
-    class RejectDatagram : public std::runtime_error
-    {
-    public:
-        RejectDatagram(const char* const reason) throw() :
-        std::runtime_error(reason)
-        { }
-    };
 };
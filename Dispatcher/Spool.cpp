@@ -0,0 +1,999 @@
+// System definition files.
+//
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Common definition files.
+//
+#include "PostgreSQL/PostgreSQL.hpp"
+#include "Toolkit/Report.h"
+#include "Toolkit/Times.hpp"
+
+// Local definition files.
+//
+#include "Primus/Configuration.hpp"
+#include "Primus/Statements.hpp"
+#include "Primus/UUID.hpp"
+#include "Primus/Database/Fabula.hpp"
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Dispatcher/Backpressure.hpp"
+#include "Primus/Dispatcher/Notificator.hpp"
+#include "Primus/Dispatcher/Spool.hpp"
+
+static Dispatcher::Spool* instance = NULL;
+
+static uint32_t
+Checksum(
+    const char*         data,
+    const size_t        length);
+
+static bool
+ReadFully(
+    const int           fileDescriptor,
+    char*               data,
+    const size_t        length,
+    const off_t         offset);
+
+static bool
+WriteFully(
+    const int           fileDescriptor,
+    const char*         data,
+    const size_t        length);
+
+template <typename Value>
+static void
+AppendValue(
+    std::string&        payload,
+    const Value         value);
+
+static void
+AppendText(
+    std::string&        payload,
+    const std::string&  text);
+
+template <typename Value>
+static Value
+ExtractValue(
+    const std::string&  payload,
+    size_t&             offset);
+
+static std::string
+ExtractText(
+    const std::string&  payload,
+    size_t&             offset);
+
+static unsigned long
+NumberOfReadings(const std::string& payload);
+
+static void
+StoreRecords(
+    const Dispatcher::SpoolRecordKind   kind,
+    std::vector<std::string>&           payloads);
+
+Dispatcher::Spool&
+Dispatcher::Spool::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[Spool] Already initialized");
+
+    instance = new Dispatcher::Spool();
+
+    return *instance;
+}
+
+Dispatcher::Spool&
+Dispatcher::Spool::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[Spool] Not initialized");
+
+    return *instance;
+}
+
+Dispatcher::Spool::Spool() :
+fileDescriptor(-1),
+cursorFileDescriptor(-1)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    this->enabledFlag = configuration.spool.enabled;
+    this->filePath = configuration.spool.filePath;
+    this->cursorFilePath = configuration.spool.filePath + ".cursor";
+
+    this->file.durableLength = 0;
+    this->file.cursor = 0;
+    this->file.appended = 0;
+    this->file.replayed = 0;
+    this->file.rejected = 0;
+    this->file.skipped = 0;
+
+    if (this->enabledFlag == false)
+        return;
+
+    this->open();
+    this->recover();
+}
+
+void
+Dispatcher::Spool::startService()
+{
+    if (this->enabledFlag == false)
+        return;
+
+    this->appenderThread = std::thread(&Dispatcher::Spool::AppenderThreadHandler, this);
+    this->drainerThread = std::thread(&Dispatcher::Spool::DrainerThreadHandler, this);
+}
+
+/**
+ * @brief   Put readings into spool.
+ *
+ * Completion handler is called from appender thread once readings are durable.
+ *
+ * @param   readings        Readings with resolved sensor ids.
+ * @param   completion      Completion handler.
+ */
+void
+Dispatcher::Spool::appendReadings(
+    const std::vector<Database::Reading>&   readings,
+    Dispatcher::IngestCompletion            completion)
+{
+    std::string payload;
+
+    AppendValue<uint32_t>(payload, readings.size());
+
+    for (const Database::Reading& reading : readings)
+    {
+        AppendValue<uint8_t>(payload, reading.kind);
+        AppendValue<uint64_t>(payload, reading.sensorId);
+        AppendValue<float>(payload, reading.value);
+        AppendText(payload, reading.originStamp);
+        AppendText(payload, reading.sensorToken.asString());
+    }
+
+    this->enqueue(Dispatcher::SpoolReadings, payload, completion);
+}
+
+/**
+ * @brief   Put aviso into spool.
+ *
+ * Completion handler is called from appender thread once aviso is durable.
+ */
+void
+Dispatcher::Spool::appendAviso(
+    const std::string&                      originStamp,
+    const unsigned long                     servusId,
+    const std::string&                      originatorLabel,
+    const unsigned short                    severityLevel,
+    const std::string&                      message,
+    Dispatcher::IngestCompletion            completion)
+{
+    std::string payload;
+
+    AppendValue<uint64_t>(payload, servusId);
+    AppendValue<uint16_t>(payload, severityLevel);
+    AppendText(payload, originStamp);
+    AppendText(payload, originatorLabel);
+    AppendText(payload, message);
+
+    this->enqueue(Dispatcher::SpoolAviso, payload, completion);
+}
+
+Dispatcher::SpoolStatistics
+Dispatcher::Spool::statistics()
+{
+    std::unique_lock<std::mutex> fileLock { this->file.lock };
+
+    Dispatcher::SpoolStatistics statistics;
+
+    statistics.appended = this->file.appended;
+    statistics.replayed = this->file.replayed;
+    statistics.rejected = this->file.rejected;
+    statistics.skipped = this->file.skipped;
+    statistics.backlog = this->file.durableLength - this->file.cursor;
+
+    return statistics;
+}
+
+void
+Dispatcher::Spool::open()
+{
+    this->fileDescriptor = ::open(
+            this->filePath.c_str(),
+            O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC,
+            S_IRUSR | S_IWUSR);
+    if (this->fileDescriptor == -1)
+    {
+        ReportSoftAlert("[Spool] Cannot open spool file %s: %s",
+                this->filePath.c_str(),
+                strerror(errno));
+
+        throw std::runtime_error("[Spool] Cannot open spool file");
+    }
+
+    this->cursorFileDescriptor = ::open(
+            this->cursorFilePath.c_str(),
+            O_RDWR | O_CREAT | O_CLOEXEC,
+            S_IRUSR | S_IWUSR);
+    if (this->cursorFileDescriptor == -1)
+    {
+        ReportSoftAlert("[Spool] Cannot open spool cursor file %s: %s",
+                this->cursorFilePath.c_str(),
+                strerror(errno));
+
+        throw std::runtime_error("[Spool] Cannot open spool cursor file");
+    }
+}
+
+/**
+ * @brief   Find out which part of spool file is left to be replayed.
+ *
+ * Records appended after the last stored cursor are validated,
+ * and a record torn by a crash in the middle of an append is cut off.
+ */
+void
+Dispatcher::Spool::recover()
+{
+    uint64_t cursor;
+
+    if (ReadFully(this->cursorFileDescriptor, (char*) &cursor, sizeof(cursor), 0) == false)
+        cursor = 0;
+
+    struct stat fileStatus;
+
+    if (fstat(this->fileDescriptor, &fileStatus) == -1)
+    {
+        ReportSoftAlert("[Spool] Cannot get size of spool file: %s",
+                strerror(errno));
+
+        throw std::runtime_error("[Spool] Cannot get size of spool file");
+    }
+
+    const unsigned long fileLength = fileStatus.st_size;
+
+    // Spool file has been truncated but the cursor has not been reset anymore.
+    //
+    if (cursor > fileLength)
+        cursor = 0;
+
+    unsigned long validLength = cursor;
+
+    for (;;)
+    {
+        Dispatcher::SpoolRecordHeader header;
+        std::string payload;
+
+        if (this->readRecord(validLength, header, payload) == false)
+        {
+            // Records behind a corrupted one are kept, drainer skips the corrupted one.
+            //
+            const unsigned long nextOffset = this->nextIntactRecord(validLength, fileLength);
+
+            if (nextOffset == fileLength)
+                break;
+
+            ReportWarning("[Spool] Corrupted record at offset %lu, intact records follow at offset %lu",
+                    validLength,
+                    nextOffset);
+
+            validLength = nextOffset;
+
+            continue;
+        }
+
+        validLength += sizeof(header) + header.length;
+    }
+
+    if (validLength < fileLength)
+    {
+        ReportWarning("[Spool] Cutting off %lu bytes of incomplete records from spool file",
+                fileLength - validLength);
+
+        if (ftruncate(this->fileDescriptor, validLength) == -1)
+        {
+            ReportSoftAlert("[Spool] Cannot truncate spool file: %s",
+                    strerror(errno));
+
+            throw std::runtime_error("[Spool] Cannot truncate spool file");
+        }
+    }
+
+    if (validLength > cursor)
+    {
+        ReportNotice("[Spool] %lu bytes of spooled records are left to be replayed",
+                validLength - cursor);
+    }
+
+    this->file.durableLength = validLength;
+    this->file.cursor = cursor;
+}
+
+/**
+ * @brief   Remember how far spool file has been replayed.
+ *
+ * Must be called with file lock held.
+ */
+void
+Dispatcher::Spool::storeCursor(const unsigned long cursor)
+{
+    const uint64_t value = cursor;
+
+    if ((pwrite(this->cursorFileDescriptor, &value, sizeof(value), 0) != sizeof(value)) ||
+        (fdatasync(this->cursorFileDescriptor) == -1))
+    {
+        ReportError("[Spool] Cannot store spool cursor, records may be replayed twice: %s",
+                strerror(errno));
+    }
+}
+
+void
+Dispatcher::Spool::enqueue(
+    const Dispatcher::SpoolRecordKind       kind,
+    std::string&                            payload,
+    Dispatcher::IngestCompletion            completion)
+{
+    Dispatcher::SpoolRecordHeader header;
+
+    header.magic = Dispatcher::SpoolRecordMagic;
+    header.kind = kind;
+    header.reserved = 0;
+    header.length = payload.length();
+    header.checksum = Checksum(payload.data(), payload.length());
+
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+    this->queue.records.emplace_back();
+
+    Record& record = this->queue.records.back();
+    record.payload.reserve(sizeof(header) + payload.length());
+    record.payload.append((const char*) &header, sizeof(header));
+    record.payload.append(payload);
+    record.completion = completion;
+    record.arrival = std::chrono::steady_clock::now();
+
+    this->queue.condition.notify_one();
+}
+
+/**
+ * @brief   Wait for records and take all that arrived within the maximal sync delay.
+ *
+ * @param   records         Vector to be filled with records.
+ */
+void
+Dispatcher::Spool::collectRecords(std::vector<Record>& records)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    std::unique_lock<std::mutex> queueLock { this->queue.lock };
+
+    while (this->queue.records.empty() == true)
+    {
+        this->queue.condition.wait(queueLock);
+    }
+
+    const std::chrono::steady_clock::time_point deadline =
+            this->queue.records.front().arrival +
+            std::chrono::milliseconds { configuration.spool.maximalSyncDelay };
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        this->queue.condition.wait_until(queueLock, deadline);
+    }
+
+    for (Record& record : this->queue.records)
+    {
+        records.push_back(std::move(record));
+    }
+
+    this->queue.records.clear();
+}
+
+/**
+ * @brief   Append records to spool file with one write and one sync, then complete them.
+ *
+ * In case of error the file is cut back, so that no partial records remain.
+ *
+ * @param   records         Records to be appended.
+ */
+void
+Dispatcher::Spool::appendRecords(std::vector<Record>& records)
+{
+    std::string buffer;
+
+    for (Record& record : records)
+    {
+        buffer.append(record.payload);
+    }
+
+    bool durable;
+
+    {
+        std::unique_lock<std::mutex> fileLock { this->file.lock };
+
+        durable = (WriteFully(this->fileDescriptor, buffer.data(), buffer.length()) == true) &&
+                (fdatasync(this->fileDescriptor) == 0);
+
+        if (durable == true)
+        {
+            this->file.durableLength += buffer.length();
+            this->file.appended += records.size();
+
+            this->file.condition.notify_one();
+        }
+        else
+        {
+            ReportError("[Spool] Cannot append %lu records to spool file: %s",
+                    records.size(),
+                    strerror(errno));
+
+            if (ftruncate(this->fileDescriptor, this->file.durableLength) == -1)
+            {
+                ReportSoftAlert("[Spool] Cannot cut back spool file: %s",
+                        strerror(errno));
+            }
+        }
+    }
+
+    for (Record& record : records)
+    {
+        record.completion(durable);
+    }
+}
+
+/**
+ * @brief   Read and validate a record of spool file.
+ *
+ * @param   offset          Offset of record in spool file.
+ * @param   header          Header of record.
+ * @param   payload         Payload of record.
+ *
+ * @return  True if a complete and intact record has been read.
+ */
+bool
+Dispatcher::Spool::readRecord(
+    const unsigned long                     offset,
+    Dispatcher::SpoolRecordHeader&          header,
+    std::string&                            payload)
+{
+    if (ReadFully(this->fileDescriptor, (char*) &header, sizeof(header), offset) == false)
+        return false;
+
+    if ((header.magic != Dispatcher::SpoolRecordMagic) ||
+        (header.length > Dispatcher::SpoolMaximalRecordLength))
+        return false;
+
+    payload.resize(header.length);
+
+    if (ReadFully(this->fileDescriptor, &payload[0], header.length, offset + sizeof(header)) == false)
+        return false;
+
+    return (Checksum(payload.data(), payload.length()) == header.checksum);
+}
+
+/**
+ * @brief   Find the first intact record behind a corrupted one.
+ *
+ * Spool file is scanned for record magic, a record is taken as intact
+ * only if its checksum matches and it ends within the given length.
+ *
+ * @param   offset          Offset of the corrupted record.
+ * @param   length          Offset up to which records are looked for.
+ *
+ * @return  Offset of the intact record, or length if there is none.
+ */
+unsigned long
+Dispatcher::Spool::nextIntactRecord(
+    const unsigned long                     offset,
+    const unsigned long                     length)
+{
+    static const unsigned long ChunkSize = 64 * 1024;
+
+    const uint32_t magic = Dispatcher::SpoolRecordMagic;
+
+    std::string chunk;
+
+    unsigned long chunkOffset = offset + 1;
+
+    while (chunkOffset + sizeof(Dispatcher::SpoolRecordHeader) <= length)
+    {
+        chunk.resize(std::min(ChunkSize, length - chunkOffset));
+
+        if (ReadFully(this->fileDescriptor, &chunk[0], chunk.length(), chunkOffset) == false)
+            break;
+
+        for (std::string::size_type position = 0;
+             position + sizeof(magic) <= chunk.length();
+             position++)
+        {
+            if (memcmp(chunk.data() + position, &magic, sizeof(magic)) != 0)
+                continue;
+
+            const unsigned long candidate = chunkOffset + position;
+
+            Dispatcher::SpoolRecordHeader header;
+            std::string payload;
+
+            if ((this->readRecord(candidate, header, payload) == true) &&
+                (candidate + sizeof(header) + header.length <= length))
+                return candidate;
+        }
+
+        // Magic may straddle the boundary of chunks.
+        //
+        chunkOffset += chunk.length() - (sizeof(magic) - 1);
+    }
+
+    return length;
+}
+
+/**
+ * @brief   Store records between offset and durable length to database, in order.
+ *
+ * Consecutive readings records are stored within one batch. If database is not available,
+ * the same records are retried until it is. Records database refuses to store are skipped.
+ *
+ * @param   offset          Offset of the first record not replayed yet.
+ * @param   durableLength   Offset up to which the spool file is durable.
+ */
+void
+Dispatcher::Spool::replayRecords(
+    unsigned long                           offset,
+    const unsigned long                     durableLength)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    Dispatcher::Backpressure& backpressure = Dispatcher::Backpressure::SharedInstance();
+
+    while (offset < durableLength)
+    {
+        Dispatcher::SpoolRecordHeader header;
+        std::vector<std::string> payloads(1);
+
+        if (this->readRecord(offset, header, payloads.front()) == false)
+        {
+            const unsigned long nextOffset = this->nextIntactRecord(offset, durableLength);
+
+            ReportError("[Spool] Corrupted record at offset %lu, skipping %lu bytes",
+                    offset,
+                    nextOffset - offset);
+
+            {
+                std::unique_lock<std::mutex> fileLock { this->file.lock };
+
+                this->file.skipped += nextOffset - offset;
+            }
+
+            payloads.clear();
+
+            offset = nextOffset;
+        }
+        else
+        {
+            unsigned long nextOffset = offset + sizeof(header) + header.length;
+
+            if (header.kind == Dispatcher::SpoolReadings)
+            {
+                unsigned long numberOfReadings = NumberOfReadings(payloads.front());
+
+                // Consecutive readings records are merged into one batch.
+                //
+                while (nextOffset < durableLength)
+                {
+                    Dispatcher::SpoolRecordHeader nextHeader;
+                    std::string nextPayload;
+
+                    if (this->readRecord(nextOffset, nextHeader, nextPayload) == false)
+                        break;
+
+                    if (nextHeader.kind != Dispatcher::SpoolReadings)
+                        break;
+
+                    numberOfReadings += NumberOfReadings(nextPayload);
+
+                    if (numberOfReadings > configuration.ingest.maximalBatchSize)
+                        break;
+
+                    payloads.push_back(std::move(nextPayload));
+
+                    nextOffset += sizeof(nextHeader) + nextHeader.length;
+                }
+            }
+
+            this->replayGroup((Dispatcher::SpoolRecordKind) header.kind, payloads);
+
+            offset = nextOffset;
+        }
+
+        std::unique_lock<std::mutex> fileLock { this->file.lock };
+
+        this->file.cursor = offset;
+        this->file.replayed += payloads.size();
+
+        this->storeCursor(offset);
+
+        backpressure.reportSpool(this->file.durableLength - this->file.cursor);
+    }
+}
+
+/**
+ * @brief   Store a group of records of the same kind to database.
+ *
+ * Blocks as long as database is not available. If database refuses a group
+ * of several records, they are retried one by one, so that a single broken record
+ * does not cause rejection of the others.
+ *
+ * @param   kind            Kind of records.
+ * @param   payloads        Payloads of records.
+ */
+void
+Dispatcher::Spool::replayGroup(
+    const Dispatcher::SpoolRecordKind       kind,
+    std::vector<std::string>&               payloads)
+{
+    Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+    for (;;)
+    {
+        try
+        {
+            StoreRecords(kind, payloads);
+
+            return;
+        }
+        catch (PostgreSQL::OperatorIntervention& exception)
+        {
+            ReportWarning("[Spool] Database is not available, retrying replay in %u ms: %s",
+                    configuration.spool.retryInterval,
+                    exception.what());
+
+            std::this_thread::sleep_for(
+                    std::chrono::milliseconds { configuration.spool.retryInterval });
+        }
+        catch (std::exception& exception)
+        {
+            if (payloads.size() == 1)
+            {
+                ReportError("[Spool] Spooled record has been rejected: %s",
+                        exception.what());
+
+                std::unique_lock<std::mutex> fileLock { this->file.lock };
+
+                this->file.rejected++;
+
+                return;
+            }
+
+            for (std::string& payload : payloads)
+            {
+                std::vector<std::string> single(1);
+
+                single.front().swap(payload);
+
+                this->replayGroup(kind, single);
+            }
+
+            return;
+        }
+    }
+}
+
+/**
+ * @brief   Thread handler for appender.
+ */
+void
+Dispatcher::Spool::AppenderThreadHandler(Dispatcher::Spool* spool)
+{
+    ReportNotice("[Spool] Appender thread has been started");
+
+    for (;;)
+    {
+        std::vector<Record> records;
+
+        spool->collectRecords(records);
+
+        spool->appendRecords(records);
+    }
+
+    ReportWarning("[Spool] Appender thread is going to quit");
+}
+
+/**
+ * @brief   Thread handler for drainer.
+ *
+ * Once everything has been replayed, a spool file grown large is truncated.
+ * File is truncated before the cursor is reset, so that a crash in between
+ * leaves a cursor beyond the end of file, which is recognized on recovery.
+ */
+void
+Dispatcher::Spool::DrainerThreadHandler(Dispatcher::Spool* spool)
+{
+    Dispatcher::Backpressure& backpressure = Dispatcher::Backpressure::SharedInstance();
+
+    ReportNotice("[Spool] Drainer thread has been started");
+
+    for (;;)
+    {
+        unsigned long cursor;
+        unsigned long durableLength;
+
+        {
+            std::unique_lock<std::mutex> fileLock { spool->file.lock };
+
+            backpressure.reportSpool(spool->file.durableLength - spool->file.cursor);
+
+            while (spool->file.cursor == spool->file.durableLength)
+            {
+                if ((spool->file.durableLength >= Dispatcher::SpoolCompactionThreshold) &&
+                    (ftruncate(spool->fileDescriptor, 0) == 0))
+                {
+                    ReportInfo("[Spool] Truncated spool file of %lu bytes",
+                            spool->file.durableLength);
+
+                    spool->file.durableLength = 0;
+                    spool->file.cursor = 0;
+
+                    spool->storeCursor(0);
+                }
+
+                spool->file.condition.wait(fileLock);
+            }
+
+            cursor = spool->file.cursor;
+            durableLength = spool->file.durableLength;
+        }
+
+        spool->replayRecords(cursor, durableLength);
+    }
+
+    ReportWarning("[Spool] Drainer thread is going to quit");
+}
+
+/**
+ * @brief   FNV-1a hash of a record payload.
+ */
+static uint32_t
+Checksum(
+    const char*         data,
+    const size_t        length)
+{
+    uint32_t hash = 2166136261U;
+
+    for (size_t index = 0; index < length; index++)
+    {
+        hash ^= (unsigned char) data[index];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static bool
+ReadFully(
+    const int           fileDescriptor,
+    char*               data,
+    const size_t        length,
+    const off_t         offset)
+{
+    size_t done = 0;
+
+    while (done < length)
+    {
+        const ssize_t bytesRead = pread(fileDescriptor, data + done, length - done, offset + done);
+
+        if (bytesRead == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        if (bytesRead == 0)
+            return false;
+
+        done += bytesRead;
+    }
+
+    return true;
+}
+
+static bool
+WriteFully(
+    const int           fileDescriptor,
+    const char*         data,
+    const size_t        length)
+{
+    size_t done = 0;
+
+    while (done < length)
+    {
+        const ssize_t bytesWritten = write(fileDescriptor, data + done, length - done);
+
+        if (bytesWritten == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        done += bytesWritten;
+    }
+
+    return true;
+}
+
+template <typename Value>
+static void
+AppendValue(
+    std::string&        payload,
+    const Value         value)
+{
+    payload.append((const char*) &value, sizeof(value));
+}
+
+static void
+AppendText(
+    std::string&        payload,
+    const std::string&  text)
+{
+    AppendValue<uint32_t>(payload, text.length());
+
+    payload.append(text);
+}
+
+template <typename Value>
+static Value
+ExtractValue(
+    const std::string&  payload,
+    size_t&             offset)
+{
+    Value value;
+
+    if (offset + sizeof(value) > payload.length())
+        throw std::out_of_range("Truncated spool record");
+
+    memcpy(&value, payload.data() + offset, sizeof(value));
+
+    offset += sizeof(value);
+
+    return value;
+}
+
+static std::string
+ExtractText(
+    const std::string&  payload,
+    size_t&             offset)
+{
+    const uint32_t length = ExtractValue<uint32_t>(payload, offset);
+
+    if (offset + length > payload.length())
+        throw std::out_of_range("Truncated spool record");
+
+    const std::string text = payload.substr(offset, length);
+
+    offset += length;
+
+    return text;
+}
+
+static unsigned long
+NumberOfReadings(const std::string& payload)
+{
+    size_t offset = 0;
+
+    try
+    {
+        return ExtractValue<uint32_t>(payload, offset);
+    }
+    catch (std::out_of_range&)
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief   Decode records and store them to database.
+ *
+ * @param   kind            Kind of records.
+ * @param   payloads        Payloads of records.
+ *
+ * @throw   PostgreSQL::OperatorIntervention    In case database is not available.
+ * @throw   std::exception                      In case records cannot be stored.
+ */
+static void
+StoreRecords(
+    const Dispatcher::SpoolRecordKind   kind,
+    std::vector<std::string>&           payloads)
+{
+    switch (kind)
+    {
+        case Dispatcher::SpoolReadings:
+        {
+            std::vector<Database::Reading> readings;
+
+            for (const std::string& payload : payloads)
+            {
+                size_t offset = 0;
+
+                const uint32_t numberOfReadings = ExtractValue<uint32_t>(payload, offset);
+
+                for (uint32_t index = 0; index < numberOfReadings; index++)
+                {
+                    const uint8_t kind = ExtractValue<uint8_t>(payload, offset);
+                    const uint64_t sensorId = ExtractValue<uint64_t>(payload, offset);
+                    const float value = ExtractValue<float>(payload, offset);
+                    std::string originStamp = ExtractText(payload, offset);
+                    const std::string sensorToken = ExtractText(payload, offset);
+
+                    double stamp;
+
+                    if (Primus::ParseStamp(
+                            Primus::StatementView { originStamp.data(), (unsigned int) originStamp.length() },
+                            stamp) == false)
+                    {
+                        throw std::invalid_argument("Bad timestamp of spooled reading");
+                    }
+
+                    readings.emplace_back(
+                            (Database::ReadingKind) kind,
+                            std::move(originStamp),
+                            stamp,
+                            Primus::UUID::FromString(sensorToken),
+                            value);
+
+                    readings.back().sensorId = sensorId;
+                }
+            }
+
+            Database::NoticeSensorReadings(readings);
+
+            break;
+        }
+
+        case Dispatcher::SpoolAviso:
+        {
+            Dispatcher::Notificator& notificator = Dispatcher::Notificator::SharedInstance();
+
+            for (const std::string& payload : payloads)
+            {
+                size_t offset = 0;
+
+                const uint64_t servusId = ExtractValue<uint64_t>(payload, offset);
+                const uint16_t severityLevel = ExtractValue<uint16_t>(payload, offset);
+                const std::string originStamp = ExtractText(payload, offset);
+                const std::string originatorLabel = ExtractText(payload, offset);
+                const std::string message = ExtractText(payload, offset);
+
+                Toolkit::Timestamp timestamp(originStamp);
+
+                Database::Fabula::Enqueue(
+                        timestamp,
+                        servusId,
+                        originatorLabel,
+                        severityLevel,
+                        message);
+            }
+
+            notificator.triggerProcessing();
+
+            break;
+        }
+
+        default:
+            throw std::invalid_argument("Unknown kind of spool record");
+    }
+}
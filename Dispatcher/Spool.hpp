@@ -0,0 +1,199 @@
+#pragma once
+
+// System definition files.
+//
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Local definition files.
+//
+#include "Primus/Database/Readings.hpp"
+#include "Primus/Dispatcher/Ingest.hpp"
+
+namespace Dispatcher
+{
+    static const uint32_t SpoolRecordMagic              = 0x50534C31;   /**< "PSL1". */
+
+    /**
+     * Records longer than this are considered corrupted.
+     */
+    static const uint32_t SpoolMaximalRecordLength      = 16 * 1024 * 1024;
+
+    /**
+     * Spool file is truncated once everything has been replayed
+     * and it has grown beyond this size.
+     */
+    static const unsigned long SpoolCompactionThreshold = 4 * 1024 * 1024;
+
+    enum SpoolRecordKind
+    {
+        SpoolReadings   = 1,
+        SpoolAviso      = 2
+    };
+
+    /**
+     * Header preceding every record in spool file.
+     * Spool file never leaves the host, therefore header is kept in host byte order.
+     */
+    struct SpoolRecordHeader
+    {
+        uint32_t        magic;
+        uint16_t        kind;
+        uint16_t        reserved;
+        uint32_t        length;             /**< Length of payload following the header. */
+        uint32_t        checksum;           /**< FNV-1a of payload. */
+    };
+
+    struct SpoolStatistics
+    {
+        unsigned long   appended;           /**< Records made durable in spool file. */
+        unsigned long   replayed;           /**< Records taken over by drainer, rejected ones included. */
+        unsigned long   rejected;           /**< Records database refused to store. */
+        unsigned long   skipped;            /**< Bytes of corrupted records passed over by drainer. */
+        unsigned long   backlog;            /**< Bytes of spool file not yet replayed. */
+    };
+
+    /**
+     * Durable local spool for readings and avisos.
+     *
+     * Records are appended to a file and acknowledged as soon as the file has been synced,
+     * which is done once for all records arrived within the maximal sync delay.
+     * A drainer replays records to database in the order they were appended,
+     * also those left over from before a restart.
+     */
+    class Spool
+    {
+    private:
+        struct Record
+        {
+            std::string                             payload;        /**< Header and payload. */
+            Dispatcher::IngestCompletion            completion;
+            std::chrono::steady_clock::time_point   arrival;
+        };
+
+        bool            enabledFlag;
+        std::string     filePath;
+        std::string     cursorFilePath;
+
+        int             fileDescriptor;
+        int             cursorFileDescriptor;
+
+        /**
+         * Thread handler of appender and drainer threads.
+         */
+        std::thread     appenderThread;
+        std::thread     drainerThread;
+
+        struct
+        {
+            std::mutex              lock;
+            std::condition_variable condition;
+            std::deque<Record>      records;
+        }
+        queue;
+
+        /**
+         * State of spool file shared by appender and drainer.
+         */
+        struct
+        {
+            std::mutex              lock;
+            std::condition_variable condition;
+            unsigned long           durableLength;  /**< Bytes synced to spool file. */
+            unsigned long           cursor;         /**< Bytes already replayed. */
+            unsigned long           appended;
+            unsigned long           replayed;
+            unsigned long           rejected;
+            unsigned long           skipped;
+        }
+        file;
+
+    public:
+        static Dispatcher::Spool&
+        InitInstance();
+
+        static Dispatcher::Spool&
+        SharedInstance();
+
+        Spool();
+
+        void
+        startService();
+
+        bool
+        enabled() const
+        { return this->enabledFlag; }
+
+        void
+        appendReadings(
+            const std::vector<Database::Reading>&   readings,
+            Dispatcher::IngestCompletion            completion);
+
+        void
+        appendAviso(
+            const std::string&                      originStamp,
+            const unsigned long                     servusId,
+            const std::string&                      originatorLabel,
+            const unsigned short                    severityLevel,
+            const std::string&                      message,
+            Dispatcher::IngestCompletion            completion);
+
+        Dispatcher::SpoolStatistics
+        statistics();
+
+    private:
+        void
+        open();
+
+        void
+        recover();
+
+        void
+        storeCursor(const unsigned long cursor);
+
+        void
+        enqueue(
+            const Dispatcher::SpoolRecordKind       kind,
+            std::string&                            payload,
+            Dispatcher::IngestCompletion            completion);
+
+        void
+        collectRecords(std::vector<Record>& records);
+
+        void
+        appendRecords(std::vector<Record>& records);
+
+        bool
+        readRecord(
+            const unsigned long                     offset,
+            Dispatcher::SpoolRecordHeader&          header,
+            std::string&                            payload);
+
+        unsigned long
+        nextIntactRecord(
+            const unsigned long                     offset,
+            const unsigned long                     length);
+
+        void
+        replayRecords(
+            unsigned long                           offset,
+            const unsigned long                     durableLength);
+
+        void
+        replayGroup(
+            const Dispatcher::SpoolRecordKind       kind,
+            std::vector<std::string>&               payloads);
+
+        static void
+        AppenderThreadHandler(Dispatcher::Spool*);
+
+        static void
+        DrainerThreadHandler(Dispatcher::Spool*);
+    };
+};
@@ -0,0 +1,246 @@
+// System definition files.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+// Local definition files.
+//
+#include "Primus/Dispatcher/TimerWheel.hpp"
+
+static void
+Unlink(Dispatcher::Timer& timer);
+
+static void
+Link(
+    Dispatcher::Timer&  head,
+    Dispatcher::Timer&  timer);
+
+Dispatcher::TimerWheel::TimerWheel() :
+origin(std::chrono::steady_clock::now()),
+currentTick(0),
+numberOfArmedTimers(0)
+{
+    for (unsigned int level = 0; level < Dispatcher::TimerWheelLevels; level++)
+    {
+        for (unsigned int slot = 0; slot < Dispatcher::TimerWheelSlotsPerLevel; slot++)
+        {
+            Dispatcher::TimerWheel::InitTimer(this->slots[level][slot], nullptr);
+        }
+    }
+
+    for (unsigned int reason = 0; reason < Dispatcher::NumberOfTimerReasons; reason++)
+    {
+        this->numberOfExpirations[reason] = 0;
+    }
+}
+
+/**
+ * @brief   Prepare a timer for use. Timer is disarmed.
+ *
+ * @param   timer           Timer to be initialized.
+ * @param   owner           Object the timer belongs to.
+ */
+void
+Dispatcher::TimerWheel::InitTimer(
+    Dispatcher::Timer&  timer,
+    void*               owner)
+{
+    timer.next = &timer;
+    timer.previous = &timer;
+    timer.expiry = 0;
+    timer.reason = Dispatcher::FirstDatagramTimeout;
+    timer.owner = owner;
+}
+
+/**
+ * @brief   Arm a timer, or rearm it if it is armed already.
+ *
+ * @param   timer           Timer to be armed.
+ * @param   delay           Milliseconds until expiration.
+ * @param   reason          Reason reported upon expiration.
+ */
+void
+Dispatcher::TimerWheel::arm(
+    Dispatcher::Timer&              timer,
+    const unsigned int              delay,
+    const Dispatcher::TimerReason   reason)
+{
+    this->disarm(timer);
+
+    const unsigned long ticks = (delay + Dispatcher::TimerWheelTick - 1) / Dispatcher::TimerWheelTick;
+
+    timer.expiry = std::max(this->tickOfNow(), this->currentTick) + std::max(ticks, 1UL);
+    timer.reason = reason;
+
+    this->insert(timer);
+
+    this->numberOfArmedTimers++;
+}
+
+void
+Dispatcher::TimerWheel::disarm(Dispatcher::Timer& timer)
+{
+    if (Dispatcher::TimerWheel::TimerArmed(timer) == false)
+        return;
+
+    Unlink(timer);
+
+    this->numberOfArmedTimers--;
+}
+
+/**
+ * @brief   Advance wheel to current time and collect expired timers.
+ *
+ * Expired timers are disarmed and their expirations are counted.
+ *
+ * @param   expired         Vector to be filled with expired timers.
+ */
+void
+Dispatcher::TimerWheel::advance(std::vector<Dispatcher::Timer*>& expired)
+{
+    const unsigned long tickOfNow = this->tickOfNow();
+
+    while (this->currentTick < tickOfNow)
+    {
+        this->currentTick++;
+
+        const unsigned int slot = this->currentTick & (Dispatcher::TimerWheelSlotsPerLevel - 1);
+
+        // Level 0 completed a round, so timers of the next round are brought down.
+        //
+        if (slot == 0)
+            this->cascade(1);
+
+        Dispatcher::Timer& head = this->slots[0][slot];
+
+        while (head.next != &head)
+        {
+            Dispatcher::Timer& timer = *head.next;
+
+            Unlink(timer);
+
+            this->numberOfArmedTimers--;
+            this->numberOfExpirations[timer.reason]++;
+
+            expired.push_back(&timer);
+        }
+    }
+}
+
+Dispatcher::TimerStatistics
+Dispatcher::TimerWheel::statistics() const
+{
+    Dispatcher::TimerStatistics statistics;
+
+    statistics.armed = this->numberOfArmedTimers;
+
+    for (unsigned int reason = 0; reason < Dispatcher::NumberOfTimerReasons; reason++)
+    {
+        statistics.expirations[reason] = this->numberOfExpirations[reason];
+    }
+
+    return statistics;
+}
+
+unsigned long
+Dispatcher::TimerWheel::tickOfNow() const
+{
+    const std::chrono::steady_clock::duration elapsed =
+            std::chrono::steady_clock::now() - this->origin;
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() /
+            Dispatcher::TimerWheelTick;
+}
+
+/**
+ * @brief   Link timer into the slot matching its distance from current tick.
+ */
+void
+Dispatcher::TimerWheel::insert(Dispatcher::Timer& timer)
+{
+    const unsigned int topLevel = Dispatcher::TimerWheelLevels - 1;
+    const unsigned int topShift = Dispatcher::TimerWheelSlotBits * topLevel;
+
+    // Timers beyond the range of the wheel are parked in the farthest slot
+    // and cascaded again until they are due.
+    //
+    const unsigned long farthestExpiry =
+            ((this->currentTick >> topShift) + Dispatcher::TimerWheelSlotsPerLevel - 1) << topShift;
+
+    const unsigned long expiry = std::min(std::max(timer.expiry, this->currentTick), farthestExpiry);
+
+    // Level is chosen by the distance between slots rather than between ticks,
+    // so that a timer never lands in a slot that has been cascaded already.
+    //
+    unsigned int level = 0;
+
+    while ((level < topLevel) &&
+           ((expiry >> (Dispatcher::TimerWheelSlotBits * level)) -
+            (this->currentTick >> (Dispatcher::TimerWheelSlotBits * level)) >=
+            Dispatcher::TimerWheelSlotsPerLevel))
+    {
+        level++;
+    }
+
+    const unsigned int slot =
+            (expiry >> (Dispatcher::TimerWheelSlotBits * level)) &
+            (Dispatcher::TimerWheelSlotsPerLevel - 1);
+
+    Link(this->slots[level][slot], timer);
+}
+
+/**
+ * @brief   Move timers of the current slot of a level down to lower levels.
+ *
+ * @param   level           Level whose current slot is cascaded.
+ */
+void
+Dispatcher::TimerWheel::cascade(const unsigned int level)
+{
+    if (level >= Dispatcher::TimerWheelLevels)
+        return;
+
+    const unsigned int slot =
+            (this->currentTick >> (Dispatcher::TimerWheelSlotBits * level)) &
+            (Dispatcher::TimerWheelSlotsPerLevel - 1);
+
+    // This level completed a round as well, so the level above has to be cascaded first.
+    //
+    if (slot == 0)
+        this->cascade(level + 1);
+
+    Dispatcher::Timer& head = this->slots[level][slot];
+
+    while (head.next != &head)
+    {
+        Dispatcher::Timer& timer = *head.next;
+
+        Unlink(timer);
+
+        this->insert(timer);
+    }
+}
+
+static void
+Unlink(Dispatcher::Timer& timer)
+{
+    timer.previous->next = timer.next;
+    timer.next->previous = timer.previous;
+
+    timer.next = &timer;
+    timer.previous = &timer;
+}
+
+static void
+Link(
+    Dispatcher::Timer&  head,
+    Dispatcher::Timer&  timer)
+{
+    timer.next = &head;
+    timer.previous = head.previous;
+
+    head.previous->next = &timer;
+    head.previous = &timer;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+// System definition files.
+//
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace Dispatcher
+{
+    static const unsigned int TimerWheelTick            = 100;      /**< Milliseconds. */
+    static const unsigned int TimerWheelSlotBits        = 8;
+    static const unsigned int TimerWheelSlotsPerLevel   = 1 << TimerWheelSlotBits;
+    static const unsigned int TimerWheelLevels          = 3;
+
+    enum TimerReason
+    {
+        FirstDatagramTimeout,
+        DatagramCompletionTimeout,
+        KeepAliveTimeout,
+        TransmissionTimeout,
+        NumberOfTimerReasons
+    };
+
+    /**
+     * Timer embedded in the object it belongs to.
+     * Armed timers are linked into a slot of the wheel.
+     */
+    struct Timer
+    {
+        Dispatcher::Timer*          next;
+        Dispatcher::Timer*          previous;
+        unsigned long               expiry;         /**< Tick at which timer expires. */
+        Dispatcher::TimerReason     reason;
+        void*                       owner;
+    };
+
+    struct TimerStatistics
+    {
+        unsigned long   armed;
+        unsigned long   expirations[Dispatcher::NumberOfTimerReasons];
+    };
+
+    /**
+     * Hierarchical timer wheel.
+     *
+     * Level 0 has one slot per tick, every next level has one slot per round
+     * of the level below. Timers are cascaded down one level whenever
+     * the level below completes a round, so arming, disarming and expiring
+     * a timer costs constant time regardless of the number of timers.
+     *
+     * Wheel is not thread-safe - it is owned by one event loop. Statistics may be read by any thread.
+     */
+    class TimerWheel
+    {
+    private:
+        std::chrono::steady_clock::time_point   origin;
+        unsigned long                           currentTick;
+
+        /**
+         * Slot heads of circular timer lists.
+         */
+        Dispatcher::Timer slots[Dispatcher::TimerWheelLevels][Dispatcher::TimerWheelSlotsPerLevel];
+
+        std::atomic<unsigned long> numberOfArmedTimers;
+        std::atomic<unsigned long> numberOfExpirations[Dispatcher::NumberOfTimerReasons];
+
+    public:
+        TimerWheel();
+
+        static void
+        InitTimer(
+            Dispatcher::Timer&  timer,
+            void*               owner);
+
+        static bool
+        TimerArmed(const Dispatcher::Timer& timer)
+        { return timer.next != &timer; }
+
+        void
+        arm(
+            Dispatcher::Timer&          timer,
+            const unsigned int          delay,
+            const Dispatcher::TimerReason reason);
+
+        void
+        disarm(Dispatcher::Timer& timer);
+
+        void
+        advance(std::vector<Dispatcher::Timer*>& expired);
+
+        Dispatcher::TimerStatistics
+        statistics() const;
+
+    private:
+        unsigned long
+        tickOfNow() const;
+
+        void
+        insert(Dispatcher::Timer& timer);
+
+        void
+        cascade(const unsigned int level);
+    };
+};
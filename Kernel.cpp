@@ -20,11 +20,23 @@
 //
 #include "Primus/Configuration.hpp"
 #include "Primus/Kernel.hpp"
+#include "Primus/ReceiveBuffers.hpp"
 #include "Primus/Anticipator/Service.hpp"
 #include "Primus/Database/Database.hpp"
 #include "Primus/Database/Debug.hpp"
+#include "Primus/Database/Notifications.hpp"
+#include "Primus/Database/SensorTokens.hpp"
+#include "Primus/Database/ServusCache.hpp"
+#include "Primus/Database/ServusConfigurations.hpp"
+#include "Primus/Database/ServusPresence.hpp"
+#include "Primus/Dispatcher/Backpressure.hpp"
+#include "Primus/Dispatcher/Ingest.hpp"
 #include "Primus/Dispatcher/Notificator.hpp"
+#include "Primus/Dispatcher/Responses.hpp"
+#include "Primus/Dispatcher/RateLimits.hpp"
+#include "Primus/Dispatcher/Retransmissions.hpp"
 #include "Primus/Dispatcher/Service.hpp"
+#include "Primus/Dispatcher/Spool.hpp"
 #include "Primus/WWW/Home.hpp"
 #include "Primus/WWW/SessionManager.hpp"
 
@@ -77,7 +89,19 @@ Workspace::Kernel::kernelInit()
         Primus::Database::InitInstance(Primus::Database::Sensors);
         Primus::Database::InitInstance(Primus::Database::WWW);
         Primus::Debug::InitInstance();
+        Primus::ReceiveBufferPool::InitInstance();
+        Database::Notifications::InitInstance();
+        Database::SensorTokens::InitInstance();
+        Database::ServusCache::InitInstance();
+        Database::ServusConfigurations::InitInstance();
+        Database::ServusPresence::InitInstance();
         Dispatcher::Notificator::InitInstance();
+        Dispatcher::Backpressure::InitInstance();
+        Dispatcher::Ingest::InitInstance();
+        Dispatcher::Spool::InitInstance();
+        Dispatcher::ResponseTemplates::InitInstance();
+        Dispatcher::RateLimits::InitInstance();
+        Dispatcher::Retransmissions::InitInstance();
         Dispatcher::Service::InitInstance();
         Anticipator::Service::InitInstance();
         APNS::Service::InitInstance();
@@ -120,9 +144,24 @@ Workspace::Kernel::kernelInit()
 void
 Workspace::Kernel::kernelExec()
 {
+    Primus::Debug& debug = Primus::Debug::SharedInstance();
+    debug.startService();
+
+    Database::Notifications& notifications = Database::Notifications::SharedInstance();
+    notifications.startService();
+
+    Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
+    presence.startService();
+
     Dispatcher::Notificator& notificator = Dispatcher::Notificator::SharedInstance();
     notificator.startService();
 
+    Dispatcher::Ingest& ingest = Dispatcher::Ingest::SharedInstance();
+    ingest.startService();
+
+    Dispatcher::Spool& spool = Dispatcher::Spool::SharedInstance();
+    spool.startService();
+
     try
     {
         this->http->startService();
@@ -92,6 +92,70 @@ Primus::Configuration::load()
             this->servus.waitForDatagramCompletion  = servusSetting["WaitForDatagramCompletion"];
             this->servus.intervalBetweenNeutrinos   = servusSetting["IntervalBetweenNeutrinos"];
             this->servus.finalWaitForNeutrino       = servusSetting["FinalWaitForNeutrino"];
+
+            // Engine is optional - sessions run in own threads unless told otherwise.
+            //
+            try
+            {
+                const std::string engine = servusSetting["Engine"];
+
+                if (engine == "Events")
+                {
+                    this->servus.engine = Primus::EventDriven;
+                }
+                else if (engine == "Threads")
+                {
+                    this->servus.engine = Primus::ThreadPerSession;
+                }
+                else
+                {
+                    ReportError("[Workspace] Unknown servus engine \"%s\"", engine.c_str());
+                }
+
+                this->servus.numberOfEventLoops = servusSetting["EventLoops"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+
+            // Throttled interval is optional - servuses are asked to slow down
+            // to the default one unless told otherwise.
+            //
+            try
+            {
+                this->servus.throttledIntervalBetweenNeutrinos =
+                        servusSetting["ThrottledIntervalBetweenNeutrinos"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+
+            // Number of acceptors is optional - one thread accepts sessions unless told otherwise.
+            //
+            try
+            {
+                this->servus.numberOfAcceptors = servusSetting["Acceptors"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+
+            // Limit of datagrams per remote address is optional.
+            //
+            try
+            {
+                this->servus.addressDatagramRate    = servusSetting["AddressDatagramRate"];
+                this->servus.addressDatagramBurst   = servusSetting["AddressDatagramBurst"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+
+            // Limit of datagrams per servus is optional.
+            //
+            try
+            {
+                this->servus.datagramRate           = servusSetting["DatagramRate"];
+                this->servus.datagramBurst          = servusSetting["DatagramBurst"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
         }
 
         // Anticipator block.
@@ -124,7 +188,72 @@ Primus::Configuration::load()
             this->phoenix.delayResponseForLogin     = anticipatorSetting["DelayResponseForLogin"];
             this->phoenix.delayResponseForRejected  = anticipatorSetting["DelayResponseForRejected"];
             this->phoenix.keepAlive                 = anticipatorSetting["KeepAlive"];
+
+            try
+            {
+                this->phoenix.numberOfAcceptors = anticipatorSetting["Acceptors"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+        }
+
+        // Ingest block is optional - defaults apply to configurations that predate it.
+        //
+        try
+        {
+            Setting &ingestSetting = rootSetting["Ingest"];
+
+            this->ingest.maximalBatchSize   = ingestSetting["MaximalBatchSize"];
+            this->ingest.maximalBatchDelay  = ingestSetting["MaximalBatchDelay"];
+
+            // Throttle thresholds are optional.
+            //
+            try
+            {
+                this->ingest.throttleQueuedReadings = ingestSetting["ThrottleQueuedReadings"];
+                this->ingest.throttleDepositLatency = ingestSetting["ThrottleDepositLatency"];
+                this->ingest.throttleSpoolBacklog   = ingestSetting["ThrottleSpoolBacklog"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+
+            // Queue limits are optional.
+            //
+            try
+            {
+                this->ingest.maximalQueuedReadings  = ingestSetting["MaximalQueuedReadings"];
+                this->ingest.maximalQueuedAvisos    = ingestSetting["MaximalQueuedAvisos"];
+            }
+            catch (SettingNotFoundException &exception)
+            { }
+        }
+        catch (SettingNotFoundException &exception)
+        { }
+
+        if (this->ingest.maximalBatchSize == 0)
+        {
+            this->ingest.maximalBatchSize = 1;
+        }
+        else if (this->ingest.maximalBatchSize > Primus::MaximalIngestBatchSize)
+        {
+            this->ingest.maximalBatchSize = Primus::MaximalIngestBatchSize;
+        }
+
+        // Spool block is optional - readings and avisos go straight to database without it.
+        //
+        try
+        {
+            Setting &spoolSetting = rootSetting["Spool"];
+
+            const std::string filePath = spoolSetting["FilePath"];
+
+            this->spool.enabled             = spoolSetting["Enabled"];
+            this->spool.filePath            = filePath;
+            this->spool.maximalSyncDelay    = spoolSetting["MaximalSyncDelay"];
+            this->spool.retryInterval       = spoolSetting["RetryInterval"];
         }
+        catch (SettingNotFoundException &exception)
+        { }
 
         // APNS block.
         //
@@ -0,0 +1,168 @@
+// System definition files.
+//
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Common definition files.
+//
+#include "Toolkit/Report.h"
+
+// Local definition files.
+//
+#include "Primus/ReceiveBuffers.hpp"
+
+static Primus::ReceiveBufferPool* instance = NULL;
+
+Primus::ReceiveBufferPool&
+Primus::ReceiveBufferPool::InitInstance()
+{
+    if (instance != NULL)
+        throw std::runtime_error("[ReceiveBuffers] Already initialized");
+
+    instance = new Primus::ReceiveBufferPool();
+
+    return *instance;
+}
+
+Primus::ReceiveBufferPool&
+Primus::ReceiveBufferPool::SharedInstance()
+{
+    if (instance == NULL)
+        throw std::runtime_error("[ReceiveBuffers] Not initialized");
+
+    return *instance;
+}
+
+unsigned int
+Primus::ReceiveBufferPool::SizeOf(const Primus::ReceiveBufferClass bufferClass)
+{
+    return (bufferClass == Primus::SmallReceiveBuffer)
+            ? Primus::SmallReceiveBufferSize
+            : Primus::LargeReceiveBufferSize;
+}
+
+Primus::ReceiveBufferPool::ReceiveBufferPool()
+{
+    for (unsigned int bufferClass = 0;
+         bufferClass < Primus::NumberOfReceiveBufferClasses;
+         bufferClass++)
+    {
+        this->classes[bufferClass].idle.reserve(Primus::MaximalNumberOfIdleReceiveBuffers);
+        this->classes[bufferClass].statistics = { 0, 0, 0, 0, 0 };
+    }
+}
+
+/**
+ * @brief   Take a buffer out of the pool, allocate a new one if none is idle.
+ *
+ * @param   bufferClass     Size class of the buffer.
+ *
+ * @return  Pointer to the buffer.
+ */
+char*
+Primus::ReceiveBufferPool::acquire(const Primus::ReceiveBufferClass bufferClass)
+{
+    char* buffer = NULL;
+
+    {
+        std::unique_lock<std::mutex> poolLock { this->lock };
+
+        Primus::ReceiveBufferStatistics& statistics = this->classes[bufferClass].statistics;
+
+        statistics.acquisitions++;
+        statistics.inUse++;
+
+        if (statistics.inUse > statistics.peakInUse)
+            statistics.peakInUse = statistics.inUse;
+
+        std::vector<char*>& idle = this->classes[bufferClass].idle;
+
+        if (idle.empty() == false)
+        {
+            buffer = idle.back();
+            idle.pop_back();
+
+            statistics.idle--;
+        }
+        else
+        {
+            statistics.allocations++;
+        }
+    }
+
+    if (buffer == NULL)
+    {
+        buffer = (char*) malloc(Primus::ReceiveBufferPool::SizeOf(bufferClass));
+        if (buffer == NULL)
+        {
+            std::unique_lock<std::mutex> poolLock { this->lock };
+
+            this->classes[bufferClass].statistics.inUse--;
+
+            ReportSoftAlert("[ReceiveBuffers] Out of memory");
+
+            throw std::runtime_error("[ReceiveBuffers] Out of memory");
+        }
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief   Give a buffer back to the pool.
+ *
+ * @param   bufferClass     Size class the buffer has been acquired with.
+ * @param   buffer          Pointer to the buffer.
+ */
+void
+Primus::ReceiveBufferPool::release(
+    const Primus::ReceiveBufferClass    bufferClass,
+    char*                               buffer)
+{
+    {
+        std::unique_lock<std::mutex> poolLock { this->lock };
+
+        Primus::ReceiveBufferStatistics& statistics = this->classes[bufferClass].statistics;
+
+        statistics.inUse--;
+
+        std::vector<char*>& idle = this->classes[bufferClass].idle;
+
+        if (idle.size() < Primus::MaximalNumberOfIdleReceiveBuffers)
+        {
+            idle.push_back(buffer);
+
+            statistics.idle++;
+
+            return;
+        }
+    }
+
+    free(buffer);
+}
+
+Primus::ReceiveBufferStatistics
+Primus::ReceiveBufferPool::statistics(const Primus::ReceiveBufferClass bufferClass)
+{
+    std::unique_lock<std::mutex> poolLock { this->lock };
+
+    return this->classes[bufferClass].statistics;
+}
+
+Primus::ReceiveBuffer::ReceiveBuffer(const Primus::ReceiveBufferClass bufferClass) :
+bufferClass(bufferClass)
+{
+    Primus::ReceiveBufferPool& pool = Primus::ReceiveBufferPool::SharedInstance();
+
+    this->data = pool.acquire(bufferClass);
+    this->size = Primus::ReceiveBufferPool::SizeOf(bufferClass);
+}
+
+Primus::ReceiveBuffer::~ReceiveBuffer()
+{
+    Primus::ReceiveBufferPool& pool = Primus::ReceiveBufferPool::SharedInstance();
+
+    pool.release(this->bufferClass, this->data);
+}
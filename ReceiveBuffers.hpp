@@ -0,0 +1,92 @@
+#pragma once
+
+// System definition files.
+//
+#include <mutex>
+#include <vector>
+
+namespace Primus
+{
+    static const unsigned int SmallReceiveBufferSize            = 4 * 1024;
+    static const unsigned int LargeReceiveBufferSize            = 64 * 1024;
+
+    /**
+     * Number of released buffers kept for reuse per size class.
+     * Buffers released beyond that are given back to the system.
+     */
+    static const unsigned int MaximalNumberOfIdleReceiveBuffers = 32;
+
+    enum ReceiveBufferClass
+    {
+        SmallReceiveBuffer,
+        LargeReceiveBuffer,
+        NumberOfReceiveBufferClasses
+    };
+
+    struct ReceiveBufferStatistics
+    {
+        unsigned long   acquisitions;       /**< Buffers handed out so far. */
+        unsigned long   allocations;        /**< Buffers allocated because none was idle. */
+        unsigned long   inUse;              /**< Buffers currently handed out. */
+        unsigned long   peakInUse;          /**< Maximal number of buffers handed out at once. */
+        unsigned long   idle;               /**< Buffers kept for reuse. */
+    };
+
+    /**
+     * Pool of receive buffers shared by all sessions.
+     * A session holds a buffer only while it is receiving a chunk.
+     */
+    class ReceiveBufferPool
+    {
+    private:
+        std::mutex lock;
+
+        struct
+        {
+            std::vector<char*>              idle;
+            Primus::ReceiveBufferStatistics statistics;
+        }
+        classes[Primus::NumberOfReceiveBufferClasses];
+
+    public:
+        static Primus::ReceiveBufferPool&
+        InitInstance();
+
+        static Primus::ReceiveBufferPool&
+        SharedInstance();
+
+        static unsigned int
+        SizeOf(const Primus::ReceiveBufferClass);
+
+        ReceiveBufferPool();
+
+        char*
+        acquire(const Primus::ReceiveBufferClass);
+
+        void
+        release(
+            const Primus::ReceiveBufferClass    bufferClass,
+            char*                               buffer);
+
+        Primus::ReceiveBufferStatistics
+        statistics(const Primus::ReceiveBufferClass);
+    };
+
+    /**
+     * Buffer taken from the pool for the lifetime of the object.
+     */
+    class ReceiveBuffer
+    {
+    private:
+        Primus::ReceiveBufferClass  bufferClass;
+
+    public:
+        char*                       data;
+        unsigned int                size;
+
+    public:
+        ReceiveBuffer(const Primus::ReceiveBufferClass);
+
+        ~ReceiveBuffer();
+    };
+};
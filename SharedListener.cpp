@@ -0,0 +1,106 @@
+// System definition files.
+//
+#include <sys/socket.h>
+#include <mutex>
+
+// Common definition files.
+//
+#include "Communicator/TCP.hpp"
+
+// Local definition files.
+//
+#include "Primus/SharedListener.hpp"
+
+Primus::SharedListener::SharedListener(
+    const IP::Family        family,
+    const unsigned short    portNumber) :
+Inherited(family, "", portNumber)
+{
+    this->recovery.generation = 0;
+    this->recovery.recovering = false;
+    this->recovery.acceptorsInside = 0;
+}
+
+/**
+ * @brief   Set up listening socket again, unless another acceptor has done it already.
+ *
+ * Socket is shut down first, so that acceptors blocked on it are woken up.
+ * It is closed only after all of them have left it.
+ *
+ * @param   failedGeneration    Generation of socket the caller has failed on,
+ *                              zero if caller has not used any socket yet.
+ *
+ * @return  Generation of socket to be used.
+ */
+unsigned long
+Primus::SharedListener::recover(const unsigned long failedGeneration)
+{
+    std::unique_lock<std::mutex> recoveryLock { this->recovery.lock };
+
+    while (this->recovery.recovering == true)
+        this->recovery.condition.wait(recoveryLock);
+
+    if (this->recovery.generation != failedGeneration)
+        return this->recovery.generation;
+
+    this->recovery.recovering = true;
+
+    try
+    {
+        if (failedGeneration != 0)
+            shutdown(this->socket(), SHUT_RDWR);
+
+        while (this->recovery.acceptorsInside != 0)
+            this->recovery.condition.wait(recoveryLock);
+
+        this->disconnect();
+        this->connect();
+    }
+    catch (...)
+    {
+        this->recovery.recovering = false;
+        this->recovery.condition.notify_all();
+
+        throw;
+    }
+
+    this->recovery.generation++;
+    this->recovery.recovering = false;
+    this->recovery.condition.notify_all();
+
+    return this->recovery.generation;
+}
+
+/**
+ * @brief   Register acceptor as using the socket, waiting while it is recovered.
+ *
+ * @param   generation      Generation of socket the caller has been using.
+ *
+ * @return  True if caller may accept on the socket and has to call leaveSocket() afterwards,
+ *          false if socket has been set up again in the meantime and caller has to
+ *          pick up its new generation.
+ */
+bool
+Primus::SharedListener::enterSocket(const unsigned long generation)
+{
+    std::unique_lock<std::mutex> recoveryLock { this->recovery.lock };
+
+    while (this->recovery.recovering == true)
+        this->recovery.condition.wait(recoveryLock);
+
+    if (this->recovery.generation != generation)
+        return false;
+
+    this->recovery.acceptorsInside++;
+
+    return true;
+}
+
+void
+Primus::SharedListener::leaveSocket()
+{
+    std::unique_lock<std::mutex> recoveryLock { this->recovery.lock };
+
+    this->recovery.acceptorsInside--;
+    this->recovery.condition.notify_all();
+}
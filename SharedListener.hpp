@@ -0,0 +1,53 @@
+#pragma once
+
+// System definition files.
+//
+#include <condition_variable>
+#include <mutex>
+
+// Common definition files.
+//
+#include "Communicator/TCP.hpp"
+
+namespace Primus
+{
+    /**
+     * Listening socket shared by several acceptor threads.
+     *
+     * Generation is incremented every time the socket is set up again, so that
+     * only one acceptor recovers the socket after an error. While it does,
+     * the other acceptors are kept out of the socket, and the recovering one
+     * waits until those still accepting on it have left, so that no acceptor
+     * ever uses a descriptor which has been closed.
+     */
+    class SharedListener : public TCP::Service
+    {
+        typedef TCP::Service Inherited;
+
+    private:
+        struct
+        {
+            std::mutex                  lock;
+            std::condition_variable     condition;
+            unsigned long               generation;
+            bool                        recovering;
+            unsigned int                acceptorsInside;
+        }
+        recovery;
+
+    public:
+        SharedListener(
+            const IP::Family        family,
+            const unsigned short    portNumber);
+
+    protected:
+        unsigned long
+        recover(const unsigned long failedGeneration);
+
+        bool
+        enterSocket(const unsigned long generation);
+
+        void
+        leaveSocket();
+    };
+};
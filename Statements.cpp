@@ -0,0 +1,385 @@
+// System definition files.
+//
+#include <strings.h>
+#include <cmath>
+#include <cstring>
+
+// Local definition files.
+//
+#include "Primus/Statements.hpp"
+
+static const char*
+EndOfLine(
+    const char*         line,
+    const char* const   end);
+
+static Primus::StatementView
+Trimmed(
+    const char*         begin,
+    const char*         end);
+
+static bool
+ParseDecimal(
+    const Primus::StatementView&    text,
+    double&                         value);
+
+Primus::Statements::Statements() :
+numberOfStatements(0),
+payloadView { "", 0 }
+{ }
+
+/**
+ * @brief   Index statements of a complete datagram.
+ *
+ * Request line is skipped, statements are indexed up to the first empty line,
+ * whatever follows it is the payload.
+ *
+ * @param   content         Content of datagram, as long as it is not reset.
+ * @param   length          Length of content.
+ */
+void
+Primus::Statements::index(
+    const char* const   content,
+    const unsigned int  length)
+{
+    this->numberOfStatements = 0;
+    this->payloadView = { "", 0 };
+
+    const char* const end = content + length;
+
+    const char* line = EndOfLine(content, end);
+
+    while (line < end)
+    {
+        const char* next = EndOfLine(line, end);
+
+        const char* lineEnd = next;
+
+        while ((lineEnd > line) && ((lineEnd[-1] == '\n') || (lineEnd[-1] == '\r')))
+            lineEnd--;
+
+        if (lineEnd == line)
+        {
+            this->payloadView = { next, (unsigned int) (end - next) };
+
+            break;
+        }
+
+        const char* colon = (const char*) memchr(line, ':', lineEnd - line);
+
+        if ((colon != NULL) && (this->numberOfStatements < Primus::MaximalNumberOfStatements))
+        {
+            Statement& statement = this->statements[this->numberOfStatements++];
+
+            statement.name = Trimmed(line, colon);
+            statement.value = Trimmed(colon + 1, lineEnd);
+        }
+
+        line = next;
+    }
+
+    // Payload may be followed by padding, Content-Length tells how much of it is meant.
+    //
+    Primus::StatementView contentLength;
+    unsigned int payloadLength;
+
+    if ((this->find("Content-Length", contentLength) == true) &&
+        (Primus::ParseUnsigned(contentLength, payloadLength) == true) &&
+        (payloadLength < this->payloadView.length))
+    {
+        this->payloadView.length = payloadLength;
+    }
+}
+
+/**
+ * @brief   Look up a statement by name, regardless of case.
+ *
+ * @param   name            Name of statement.
+ * @param   value           View to be set to value of statement.
+ *
+ * @return  True if statement is present, false otherwise.
+ */
+bool
+Primus::Statements::find(
+    const char* const       name,
+    Primus::StatementView&  value) const
+{
+    const unsigned int nameLength = strlen(name);
+
+    for (unsigned int i = 0; i < this->numberOfStatements; i++)
+    {
+        const Statement& statement = this->statements[i];
+
+        if ((statement.name.length == nameLength) &&
+            (strncasecmp(statement.name.data, name, nameLength) == 0))
+        {
+            value = statement.value;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief   Look up a statement and parse its value as unsigned number.
+ *
+ * @param   name            Name of statement.
+ * @param   value           Number to be set to value of statement.
+ *
+ * @return  True if statement is present and is a number, false otherwise.
+ */
+bool
+Primus::Statements::findUnsigned(
+    const char* const       name,
+    unsigned int&           value) const
+{
+    Primus::StatementView text;
+
+    return (this->find(name, text) == true) && (Primus::ParseUnsigned(text, value) == true);
+}
+
+/**
+ * @brief   Look up a statement and parse its value as floating point number.
+ *
+ * @param   name            Name of statement.
+ * @param   value           Number to be set to value of statement.
+ *
+ * @return  True if statement is present and is a number, false otherwise.
+ */
+bool
+Primus::Statements::findFloat(
+    const char* const       name,
+    float&                  value) const
+{
+    Primus::StatementView text;
+
+    return (this->find(name, text) == true) && (Primus::ParseFloat(text, value) == true);
+}
+
+/**
+ * @brief   Parse decimal unsigned number filling the whole text.
+ *
+ * @return  True if text is a number within range, false otherwise.
+ */
+bool
+Primus::ParseUnsigned(
+    const Primus::StatementView&    text,
+    unsigned int&                   value)
+{
+    if (text.length == 0)
+        return false;
+
+    unsigned long number = 0;
+
+    for (unsigned int i = 0; i < text.length; i++)
+    {
+        const char digit = text.data[i];
+
+        if ((digit < '0') || (digit > '9'))
+            return false;
+
+        number = number * 10 + (digit - '0');
+
+        if (number > 0xFFFFFFFFUL)
+            return false;
+    }
+
+    value = (unsigned int) number;
+
+    return true;
+}
+
+/**
+ * @brief   Parse floating point number filling the whole text.
+ *
+ * Decimal point is always a dot, regardless of locale.
+ *
+ * @return  True if text is a number, false otherwise.
+ */
+bool
+Primus::ParseFloat(
+    const Primus::StatementView&    text,
+    float&                          value)
+{
+    double number;
+
+    if (ParseDecimal(text, number) == false)
+        return false;
+
+    // Number may fit into a double but not into a float.
+    //
+    if (std::isfinite((float) number) == false)
+        return false;
+
+    value = (float) number;
+
+    return true;
+}
+
+/**
+ * @brief   Parse timestamp as sent by servus - seconds since epoch with optional fraction.
+ *
+ * @return  True if text is a timestamp, false otherwise.
+ */
+bool
+Primus::ParseStamp(
+    const Primus::StatementView&    text,
+    double&                         stamp)
+{
+    if ((text.length == 0) || (text.data[0] < '0') || (text.data[0] > '9'))
+        return false;
+
+    return ParseDecimal(text, stamp);
+}
+
+static const char*
+EndOfLine(
+    const char*         line,
+    const char* const   end)
+{
+    const char* newLine = (const char*) memchr(line, '\n', end - line);
+
+    return (newLine == NULL) ? end : newLine + 1;
+}
+
+static Primus::StatementView
+Trimmed(
+    const char*         begin,
+    const char*         end)
+{
+    while ((begin < end) && ((*begin == ' ') || (*begin == '\t')))
+        begin++;
+
+    while ((end > begin) && ((end[-1] == ' ') || (end[-1] == '\t')))
+        end--;
+
+    return Primus::StatementView { begin, (unsigned int) (end - begin) };
+}
+
+/**
+ * @brief   Parse decimal number with optional sign, fraction and exponent in one pass.
+ *
+ * Up to 19 significant digits are collected into an integer, which is then scaled
+ * by a power of ten. Integer and scaling are each rounded to double, so the result
+ * is faithful, within one unit in the last place, but not always correctly rounded.
+ * That is far below the resolution of timestamps with microseconds and of sensor values.
+ * Numbers out of the range of double are rejected.
+ */
+static bool
+ParseDecimal(
+    const Primus::StatementView&    text,
+    double&                         value)
+{
+    static const double PowersOfTen[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* cursor = text.data;
+    const char* const end = text.data + text.length;
+
+    bool negative = false;
+
+    if ((cursor < end) && ((*cursor == '-') || (*cursor == '+')))
+    {
+        negative = (*cursor == '-');
+        cursor++;
+    }
+
+    unsigned long mantissa = 0;
+    unsigned int numberOfDigits = 0;
+    unsigned int significantDigits = 0;
+    int exponent = 0;
+
+    for (; (cursor < end) && (*cursor >= '0') && (*cursor <= '9'); cursor++, numberOfDigits++)
+    {
+        if (significantDigits < 19)
+        {
+            mantissa = mantissa * 10 + (*cursor - '0');
+
+            if (mantissa != 0)
+                significantDigits++;
+        }
+        else
+        {
+            exponent++;
+        }
+    }
+
+    if ((cursor < end) && (*cursor == '.'))
+    {
+        cursor++;
+
+        for (; (cursor < end) && (*cursor >= '0') && (*cursor <= '9'); cursor++, numberOfDigits++)
+        {
+            if (significantDigits < 19)
+            {
+                mantissa = mantissa * 10 + (*cursor - '0');
+                exponent--;
+
+                if (mantissa != 0)
+                    significantDigits++;
+            }
+        }
+    }
+
+    if (numberOfDigits == 0)
+        return false;
+
+    if ((cursor < end) && ((*cursor == 'e') || (*cursor == 'E')))
+    {
+        cursor++;
+
+        bool negativeExponent = false;
+
+        if ((cursor < end) && ((*cursor == '-') || (*cursor == '+')))
+        {
+            negativeExponent = (*cursor == '-');
+            cursor++;
+        }
+
+        if ((cursor == end) || (*cursor < '0') || (*cursor > '9'))
+            return false;
+
+        int explicitExponent = 0;
+
+        for (; (cursor < end) && (*cursor >= '0') && (*cursor <= '9'); cursor++)
+        {
+            if (explicitExponent < 1000)
+                explicitExponent = explicitExponent * 10 + (*cursor - '0');
+        }
+
+        exponent += (negativeExponent == true) ? -explicitExponent : explicitExponent;
+    }
+
+    if (cursor != end)
+        return false;
+
+    double number = (double) mantissa;
+
+    while (exponent > 22)
+    {
+        number *= 1e22;
+        exponent -= 22;
+    }
+
+    while (exponent < -22)
+    {
+        number /= 1e22;
+        exponent += 22;
+    }
+
+    number = (exponent < 0)
+            ? number / PowersOfTen[-exponent]
+            : number * PowersOfTen[exponent];
+
+    if (std::isfinite(number) == false)
+        return false;
+
+    value = (negative == true) ? -number : number;
+
+    return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// System definition files.
+//
+#include <string>
+
+namespace Primus
+{
+    /**
+     * Statements beyond this number are not indexed and cannot be looked up.
+     */
+    static const unsigned int MaximalNumberOfStatements = 32;
+
+    /**
+     * Piece of a received datagram. Valid only as long as the datagram is not reset.
+     */
+    struct StatementView
+    {
+        const char*     data;
+        unsigned int    length;
+
+        bool
+        empty() const
+        { return this->length == 0; }
+
+        std::string
+        asString() const
+        { return std::string(this->data, this->length); }
+    };
+
+    /**
+     * Index of statements of a received datagram.
+     *
+     * Statements are looked up directly in the content of the datagram,
+     * so that a value is copied only if it has to outlive the datagram.
+     * Indexing does not allocate anything.
+     */
+    class Statements
+    {
+    private:
+        struct Statement
+        {
+            Primus::StatementView   name;
+            Primus::StatementView   value;
+        };
+
+        Statement               statements[Primus::MaximalNumberOfStatements];
+        unsigned int            numberOfStatements;
+
+        Primus::StatementView   payloadView;
+
+    public:
+        Statements();
+
+        void
+        index(
+            const char* const   content,
+            const unsigned int  length);
+
+        bool
+        find(
+            const char* const       name,
+            Primus::StatementView&  value) const;
+
+        bool
+        findUnsigned(
+            const char* const       name,
+            unsigned int&           value) const;
+
+        bool
+        findFloat(
+            const char* const       name,
+            float&                  value) const;
+
+        Primus::StatementView
+        payload() const
+        { return this->payloadView; }
+    };
+
+    bool
+    ParseUnsigned(
+        const Primus::StatementView&    text,
+        unsigned int&                   value);
+
+    bool
+    ParseFloat(
+        const Primus::StatementView&    text,
+        float&                          value);
+
+    bool
+    ParseStamp(
+        const Primus::StatementView&    text,
+        double&                         stamp);
+};
@@ -0,0 +1,130 @@
+// System definition files.
+//
+#include <cstring>
+#include <string>
+
+// Local definition files.
+//
+#include "Primus/UUID.hpp"
+
+static int
+HexValue(const char character);
+
+/**
+ * @brief   Get UUID from its textual form as delivered by database.
+ *
+ * @return  Parsed UUID, or nil UUID in case text is not a UUID.
+ */
+Primus::UUID
+Primus::UUID::FromString(const std::string& text)
+{
+    Primus::UUID uuid;
+
+    if (uuid.parse(text.data(), text.length()) == false)
+        uuid = Primus::UUID();
+
+    return uuid;
+}
+
+/**
+ * @brief   Parse UUID in its canonical form, e.g. 123e4567-e89b-12d3-a456-426614174000.
+ *
+ * @param   text            Text to be parsed, need not be terminated.
+ * @param   length          Length of text.
+ *
+ * @return  True if text is a UUID, false otherwise.
+ */
+bool
+Primus::UUID::parse(
+    const char* const   text,
+    const unsigned int  length)
+{
+    if (length != Primus::UUIDTextLength)
+        return false;
+
+    unsigned int byte = 0;
+
+    for (unsigned int i = 0; i < length; )
+    {
+        if ((i == 8) || (i == 13) || (i == 18) || (i == 23))
+        {
+            if (text[i] != '-')
+                return false;
+
+            i++;
+
+            continue;
+        }
+
+        const int high = HexValue(text[i]);
+        const int low = HexValue(text[i + 1]);
+
+        if ((high < 0) || (low < 0))
+            return false;
+
+        this->bytes[byte++] = (unsigned char) ((high << 4) | low);
+
+        i += 2;
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Write UUID in its canonical form.
+ *
+ * @param   text            Buffer of at least UUIDTextLength + 1 characters, gets terminated.
+ */
+void
+Primus::UUID::format(char* const text) const
+{
+    static const char HexDigits[] = "0123456789abcdef";
+
+    char* cursor = text;
+
+    for (unsigned int byte = 0; byte < sizeof(this->bytes); byte++)
+    {
+        if ((byte == 4) || (byte == 6) || (byte == 8) || (byte == 10))
+            *cursor++ = '-';
+
+        *cursor++ = HexDigits[this->bytes[byte] >> 4];
+        *cursor++ = HexDigits[this->bytes[byte] & 0x0F];
+    }
+
+    *cursor = '\0';
+}
+
+std::string
+Primus::UUID::asString() const
+{
+    char text[Primus::UUIDTextLength + 1];
+
+    this->format(text);
+
+    return std::string(text, Primus::UUIDTextLength);
+}
+
+bool
+Primus::UUID::isNil() const
+{
+    for (unsigned int byte = 0; byte < sizeof(this->bytes); byte++)
+        if (this->bytes[byte] != 0)
+            return false;
+
+    return true;
+}
+
+static int
+HexValue(const char character)
+{
+    if ((character >= '0') && (character <= '9'))
+        return character - '0';
+
+    if ((character >= 'a') && (character <= 'f'))
+        return character - 'a' + 10;
+
+    if ((character >= 'A') && (character <= 'F'))
+        return character - 'A' + 10;
+
+    return -1;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+// System definition files.
+//
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace Primus
+{
+    /**
+     * Length of a UUID in its textual form, hyphens included.
+     */
+    static const unsigned int UUIDTextLength = 36;
+
+    /**
+     * Tokens and authenticators kept as their 16 bytes.
+     *
+     * Parsing accepts either case, so that tokens compare regardless of how
+     * a servus or phoenix spells them. Formatting always produces lower case,
+     * as PostgreSQL does.
+     */
+    class UUID
+    {
+    public:
+        unsigned char   bytes[16];
+
+    public:
+        UUID()
+        { memset(this->bytes, 0, sizeof(this->bytes)); }
+
+        static UUID
+        FromString(const std::string& text);
+
+        bool
+        parse(
+            const char* const   text,
+            const unsigned int  length);
+
+        void
+        format(char* const text) const;
+
+        std::string
+        asString() const;
+
+        bool
+        isNil() const;
+
+        bool
+        operator==(const UUID& other) const
+        { return memcmp(this->bytes, other.bytes, sizeof(this->bytes)) == 0; }
+
+        bool
+        operator!=(const UUID& other) const
+        { return memcmp(this->bytes, other.bytes, sizeof(this->bytes)) != 0; }
+
+        bool
+        operator<(const UUID& other) const
+        { return memcmp(this->bytes, other.bytes, sizeof(this->bytes)) < 0; }
+    };
+};
+
+namespace std
+{
+    template<>
+    struct hash<Primus::UUID>
+    {
+        size_t
+        operator()(const Primus::UUID& uuid) const
+        {
+            // Tokens are random, so any eight of their bytes make a good hash.
+            //
+            unsigned long half;
+
+            memcpy(&half, uuid.bytes + 8, sizeof(half));
+
+            return (size_t) half;
+        }
+    };
+};
@@ -2,6 +2,7 @@
 //
 #include <cstdbool>
 #include <string>
+#include <unordered_map>
 
 // Common definition files.
 //
@@ -66,13 +67,11 @@ WWW::Site::pageActivator(HTTP::Connection& connection, HTML::Instance& instance)
                                 return;
                             }
 
-                            Database::Activator& activator =
+                            Database::Activator activator =
                                     Database::Activators::ActivatorById(activatorId);
 
                             activator.setActivationCode(activationCode);
                             activator.setTitle(activatorTitle);
-
-                            delete &activator;
                         }
                         catch (HTTP::ArgumentDoesNotExist&)
                         {
@@ -208,14 +207,19 @@ WWW::Site::pageActivator(HTTP::Connection& connection, HTML::Instance& instance)
             {
                 HTML::TableBody tableBody(instance);
 
-                unsigned long numberOfActivators = Database::Activators::TotalNumber();
-                for (unsigned int activatorIndex = 0;
-                     activatorIndex < numberOfActivators;
-                     activatorIndex++)
+                Database::EntityList<Database::Activator> activators = Database::Activators::AllActivators();
+
+                // Phoenixes are looked up in a single query, not once per activator.
+                //
+                std::unordered_map<unsigned long, Database::Phoenix> phoenixes;
+
+                for (Database::Phoenix& phoenix : Database::Phoenixes::AllPhoenixes())
                 {
-                    Database::Activator& activator =
-                            Database::Activators::ActivatorByIndex(activatorIndex);
+                    phoenixes.emplace(phoenix.phoenixId, phoenix);
+                }
 
+                for (Database::Activator& activator : activators)
+                {
                     HTML::TableRow tableRow(instance);
 
                     {
@@ -227,10 +231,12 @@ WWW::Site::pageActivator(HTTP::Connection& connection, HTML::Instance& instance)
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "label");
 
-                        tableDataCell.plain(activator.timestamp->YYYYMMDDHHMM());
+                        tableDataCell.plain(activator.timestamp.YYYYMMDDHHMM());
                     }
 
-                    if (activator.phoenixId == 0)
+                    auto phoenix = phoenixes.find(activator.phoenixId);
+
+                    if (phoenix == phoenixes.end())
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "shadowed");
 
@@ -240,16 +246,11 @@ WWW::Site::pageActivator(HTTP::Connection& connection, HTML::Instance& instance)
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "label");
 
-                        Database::Phoenix& phoenix =
-                                Database::Phoenixes::PhoenixById(activator.phoenixId);
-
                         tableDataCell.plain("Seit %s bei ",
-                                phoenix.timestamp->YYYYMMDDHHMM().c_str());
+                                phoenix->second.timestamp.YYYYMMDDHHMM().c_str());
                         tableDataCell.setTextStyle(HTML::Bold);
-                        tableDataCell.plain(phoenix.title.c_str());
+                        tableDataCell.plain(phoenix->second.title.c_str());
                         tableDataCell.setTextStyle();
-
-                        delete &phoenix;
                     }
 
                     {
@@ -281,8 +282,6 @@ WWW::Site::pageActivator(HTTP::Connection& connection, HTML::Instance& instance)
                             url.plain("[Bearbeiten]");
                         } // HTML.URL
                     }
-
-                    delete &activator;
                 }
             }
         }
@@ -327,12 +326,10 @@ WWW::Site::pageActivatorEditForm(HTTP::Connection& connection, HTML::Instance& i
 
     if (activatorId != 0)
     {
-        Database::Activator& activator = Database::Activators::ActivatorById(activatorId);
+        Database::Activator activator = Database::Activators::ActivatorById(activatorId);
 
         activationCode = activator.activationCode;
         activatorTitle = activator.title;
-
-        delete &activator;
     }
     else
     {
@@ -149,7 +149,7 @@ WWW::Site::processRelays(HTTP::Connection& connection)
     {
         const unsigned long relayId = connection[WWW::SwitchRelay];
 
-        Database::Relay& relay = Database::Relays::RelayById(relayId);
+        Database::Relay relay = Database::Relays::RelayById(relayId);
 
         try
         {
@@ -168,8 +168,6 @@ WWW::Site::processRelays(HTTP::Connection& connection)
         {
             relay.switchOver();
         }
-
-        delete &relay;
     }
     catch (HTTP::ArgumentDoesNotExist&)
     { }
@@ -56,11 +56,9 @@ WWW::Site::pagePhoenix(HTTP::Connection& connection, HTML::Instance& instance)
                         if (phoenixTitle.empty() == true)
                             throw HTTP::ArgumentDoesNotExist();
 
-                        Database::Phoenix& phoenix = Database::Phoenixes::PhoenixById(phoenixId);
+                        Database::Phoenix phoenix = Database::Phoenixes::PhoenixById(phoenixId);
 
                         phoenix.setTitle(phoenixTitle);
-
-                        delete &phoenix;
                     }
                     catch (HTTP::ArgumentDoesNotExist&)
                     {
@@ -84,15 +82,13 @@ WWW::Site::pagePhoenix(HTTP::Connection& connection, HTML::Instance& instance)
                 {
                     unsigned long phoenixId = connection[WWW::PhoenixId];
 
-                    Database::Phoenix& phoenix = Database::Phoenixes::PhoenixById(phoenixId);
+                    Database::Phoenix phoenix = Database::Phoenixes::PhoenixById(phoenixId);
 
                     instance.noticeMessage("Phoenix <b>%s</b> und zugeordnete Push Notifications " \
                             "wurden unwiderruflich aus dem System entfernen.",
                             phoenix.title.c_str());
 
                     Database::Phoenixes::RemovePhoenixById(phoenixId);
-
-                    delete &phoenix;
                 }
                 catch (HTTP::ArgumentDoesNotExist&)
                 {
@@ -126,7 +122,7 @@ WWW::Site::pagePhoenixInfo(HTTP::Connection& connection, HTML::Instance& instanc
         //
         unsigned long phoenixId = connection[WWW::PhoenixId];
 
-        Database::Phoenix& phoenix = Database::Phoenixes::PhoenixById(phoenixId);
+        Database::Phoenix phoenix = Database::Phoenixes::PhoenixById(phoenixId);
 
         HTML::Division division(instance, "full", "slice");
 
@@ -154,7 +150,7 @@ WWW::Site::pagePhoenixInfo(HTTP::Connection& connection, HTML::Instance& instanc
                     {
                         HTML::TableDataCell tableDataCell(instance);
 
-                        tableDataCell.plain(phoenix.timestamp->YYYYMMDDHHMM());
+                        tableDataCell.plain(phoenix.timestamp.YYYYMMDDHHMM());
                     }
                 }
 
@@ -305,13 +301,10 @@ WWW::Site::pagePhoenixList(HTTP::Connection& connection, HTML::Instance& instanc
             {
                 HTML::TableBody tableBody(instance);
 
-                unsigned long numberOfPhoenixes = Database::Phoenixes::TotalNumber();
-                for (unsigned int phoenixIndex = 0;
-                     phoenixIndex < numberOfPhoenixes;
-                     phoenixIndex++)
-                {
-                    Database::Phoenix& phoenix = Database::Phoenixes::PhoenixByIndex(phoenixIndex);
+                Database::EntityList<Database::Phoenix> phoenixes = Database::Phoenixes::AllPhoenixes();
 
+                for (Database::Phoenix& phoenix : phoenixes)
+                {
                     HTML::TableRow tableRow(instance);
 
                     {
@@ -323,7 +316,7 @@ WWW::Site::pagePhoenixList(HTTP::Connection& connection, HTML::Instance& instanc
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "label");
 
-                        tableDataCell.plain(phoenix.timestamp->YYYYMMDD());
+                        tableDataCell.plain(phoenix.timestamp.YYYYMMDD());
                     }
 
                     {
@@ -397,8 +390,6 @@ WWW::Site::pagePhoenixList(HTTP::Connection& connection, HTML::Instance& instanc
                             url.plain("[Löschen]");
                         } // HTML.URL
                     }
-
-                    delete &phoenix;
                 }
             }
         }
@@ -440,11 +431,9 @@ WWW::Site::pagePhoenixEditForm(HTTP::Connection& connection, HTML::Instance& ins
 
     if (phoenixId != 0)
     {
-        Database::Phoenix& phoenix = Database::Phoenixes::PhoenixById(phoenixId);
+        Database::Phoenix phoenix = Database::Phoenixes::PhoenixById(phoenixId);
 
         phoenixTitle = phoenix.title;
-
-        delete &phoenix;
     }
 
     {
@@ -545,7 +534,7 @@ WWW::Site::generatePhoenixRemoveForm(HTTP::Connection& connection, HTML::Instanc
 
     form.hidden(WWW::PhoenixId, phoenixId);
 
-    Database::Phoenix& phoenix = Database::Phoenixes::PhoenixById(phoenixId);
+    Database::Phoenix phoenix = Database::Phoenixes::PhoenixById(phoenixId);
 
     unsigned long numberOfNotifications = phoenix.numberOfNotifications();
 
@@ -587,8 +576,6 @@ WWW::Site::generatePhoenixRemoveForm(HTTP::Connection& connection, HTML::Instanc
         }
     }
 
-    delete &phoenix;
-
     {
         HTML::FieldSet fieldSet(instance, HTML::Nothing, "south");
 
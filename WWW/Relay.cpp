@@ -14,6 +14,7 @@
 //
 #include "Primus/Database/Relay.hpp"
 #include "Primus/Database/Relays.hpp"
+#include "Primus/Database/ServusConfigurations.hpp"
 #include "Primus/WWW/Home.hpp"
 
 /**
@@ -49,11 +50,14 @@ WWW::Site::pageRelay(HTTP::Connection& connection, HTML::Instance& instance)
                         if (relayTitle.empty() == true)
                             throw HTTP::ArgumentDoesNotExist();
 
-                        Database::Relay& relay = Database::Relays::RelayById(relayId);
+                        Database::Relay relay = Database::Relays::RelayById(relayId);
 
                         relay.setTitle(relayTitle);
 
-                        delete &relay;
+                        Database::ServusConfigurations& servusConfigurations =
+                                Database::ServusConfigurations::SharedInstance();
+
+                        servusConfigurations.invalidate();
                     }
                     catch (HTTP::ArgumentDoesNotExist&)
                     {
@@ -124,13 +128,10 @@ WWW::Site::pageRelay(HTTP::Connection& connection, HTML::Instance& instance)
             {
                 HTML::TableBody tableBody(instance);
 
-                unsigned long numberOfRelays = Database::Relays::TotalNumber();
-                for (unsigned int relayIndex = 0;
-                     relayIndex < numberOfRelays;
-                     relayIndex++)
-                {
-                    Database::Relay& relay = Database::Relays::RelayByIndex(relayIndex);
+                Database::EntityList<Database::Relay> relays = Database::Relays::AllRelays();
 
+                for (Database::Relay& relay : relays)
+                {
                     HTML::TableRow tableRow(instance);
 
                     {
@@ -159,10 +160,10 @@ WWW::Site::pageRelay(HTTP::Connection& connection, HTML::Instance& instance)
                             char urlString[200];
 
                             snprintf(urlString, sizeof(urlString),
-                                    "%s?%s=%u&%s=%s",
+                                    "%s?%s=%lu&%s=%s",
                                     connection.pageName().c_str(),
                                     WWW::SwitchRelay.c_str(),
-                                    relayIndex,
+                                    relay.relayId,
                                     WWW::RelayState.c_str(),
                                     WWW::RelayStateUp.c_str());
 
@@ -187,10 +188,10 @@ WWW::Site::pageRelay(HTTP::Connection& connection, HTML::Instance& instance)
                             char urlString[200];
 
                             snprintf(urlString, sizeof(urlString),
-                                    "%s?%s=%u&%s=%s",
+                                    "%s?%s=%lu&%s=%s",
                                     connection.pageName().c_str(),
                                     WWW::SwitchRelay.c_str(),
-                                    relayIndex,
+                                    relay.relayId,
                                     WWW::RelayState.c_str(),
                                     WWW::RelayStateDown.c_str());
 
@@ -231,8 +232,6 @@ WWW::Site::pageRelay(HTTP::Connection& connection, HTML::Instance& instance)
                             url.plain("[Bearbeiten]");
                         } // HTML.URL
                     }
-
-                    delete &relay;
                 }
             }
         }
@@ -274,11 +273,9 @@ WWW::Site::pageRelayEditForm(HTTP::Connection& connection, HTML::Instance& insta
 
     if (relayId != 0)
     {
-        Database::Relay& relay = Database::Relays::RelayById(relayId);
+        Database::Relay relay = Database::Relays::RelayById(relayId);
 
         relayTitle = relay.title;
-
-        delete &relay;
     }
 
     {
@@ -12,8 +12,13 @@
 
 // Local definition files.
 //
+#include "Primus/Configuration.hpp"
 #include "Primus/Database/Servus.hpp"
+#include "Primus/Database/ServusCache.hpp"
+#include "Primus/Database/ServusConfigurations.hpp"
 #include "Primus/Database/Servuses.hpp"
+#include "Primus/Database/ServusPresence.hpp"
+#include "Primus/Dispatcher/RateLimits.hpp"
 #include "Primus/WWW/Home.hpp"
 
 /**
@@ -34,10 +39,19 @@ WWW::Site::pageServus(HTTP::Connection& connection, HTML::Instance& instance)
             {
                 const unsigned long servusId = connection[WWW::ServusId];
 
-                Database::Servus& servus = Database::Servuses::ServusById(servusId);
+                Database::Servus servus = Database::Servuses::ServusById(servusId);
 
                 servus.toggleEnabledFlag();
 
+                Database::ServusCache& servusCache = Database::ServusCache::SharedInstance();
+
+                servusCache.invalidate();
+
+                Database::ServusConfigurations& servusConfigurations =
+                        Database::ServusConfigurations::SharedInstance();
+
+                servusConfigurations.invalidate();
+
                 if (servus.enabled == true)
                 {
                     instance.infoMessage("Servus <b>%s</b> wurde <u>aktiviert</u>. " \
@@ -50,8 +64,6 @@ WWW::Site::pageServus(HTTP::Connection& connection, HTML::Instance& instance)
                             "Logins von diesem Servus werden künftig abgelehnt.",
                             servus.title.c_str());
                 }
-
-                delete &servus;
             }
             catch (HTTP::ArgumentDoesNotExist&)
             {
@@ -82,11 +94,18 @@ WWW::Site::pageServus(HTTP::Connection& connection, HTML::Instance& instance)
                         if (servusTitle.empty() == true)
                             throw HTTP::ArgumentDoesNotExist();
 
-                        Database::Servus& servus = Database::Servuses::ServusById(servusId);
+                        Database::Servus servus = Database::Servuses::ServusById(servusId);
 
                         servus.setTitle(servusTitle);
 
-                        delete &servus;
+                        Database::ServusCache& servusCache = Database::ServusCache::SharedInstance();
+
+                        servusCache.invalidate();
+
+                        Database::ServusConfigurations& servusConfigurations =
+                                Database::ServusConfigurations::SharedInstance();
+
+                        servusConfigurations.invalidate();
                     }
                     catch (HTTP::ArgumentDoesNotExist&)
                     {
@@ -152,7 +171,7 @@ WWW::Site::pageServusInfo(HTTP::Connection& connection, HTML::Instance& instance
         //
         unsigned long servusId = connection[WWW::ServusId];
 
-        Database::Servus& servus = Database::Servuses::ServusById(servusId);
+        Database::Servus servus = Database::Servuses::ServusById(servusId);
 
         HTML::Division division(instance, "full", "slice");
 
@@ -203,10 +222,17 @@ WWW::Site::pageServusInfo(HTTP::Connection& connection, HTML::Instance& instance
                     {
                         HTML::TableDataCell tableDataCell(instance);
 
-                        if (servus.online == true)
+                        Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
+
+                        Database::ServusPresenceRecord record;
+
+                        if (presence.online(servus.servusId, record) == true)
                         {
-                            tableDataCell.plain("Mit Primus verbunden (Servus läuft seit %s)",
-                                    servus.runningSince->YYYYMMDDHHMM().c_str());
+                            tableDataCell.plain("Mit Primus verbunden seit %s von %s (Servus läuft seit %s, letztes Datagramm %s)",
+                                    record.onlineSince.YYYYMMDDHHMM().c_str(),
+                                    record.remoteAddress.c_str(),
+                                    servus.runningSince.YYYYMMDDHHMM().c_str(),
+                                    record.lastDatagram.YYYYMMDDHHMM().c_str());
                         }
                         else
                         {
@@ -227,7 +253,67 @@ WWW::Site::pageServusInfo(HTTP::Connection& connection, HTML::Instance& instance
                     {
                         HTML::TableDataCell tableDataCell(instance);
 
-                        tableDataCell.plain(servus.authenticator);
+                        tableDataCell.plain(servus.authenticator.asString());
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Datenrate:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        Primus::Configuration& configuration = Primus::Configuration::SharedInstance();
+
+                        if (configuration.servus.datagramRate != 0)
+                        {
+                            tableDataCell.plain("Höchstens %u Datagramme pro Sekunde, %u auf einmal",
+                                    configuration.servus.datagramRate,
+                                    configuration.servus.datagramBurst);
+                        }
+                        else
+                        {
+                            tableDataCell.plain("Unbegrenzt");
+                        }
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Gedrosselte Datagramme:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        Dispatcher::RateLimits& rateLimits = Dispatcher::RateLimits::SharedInstance();
+
+                        Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
+
+                        Database::ServusPresenceRecord record;
+
+                        if (presence.online(servus.servusId, record) == true)
+                        {
+                            tableDataCell.plain("%lu von Servus, %lu von Adresse %s",
+                                    rateLimits.throttledByServus(servus.servusId),
+                                    rateLimits.throttledByAddress(record.remoteAddress),
+                                    record.remoteAddress.c_str());
+                        }
+                        else
+                        {
+                            tableDataCell.plain("%lu von Servus",
+                                    rateLimits.throttledByServus(servus.servusId));
+                        }
                     }
                 }
             }
@@ -332,14 +418,12 @@ WWW::Site::pageServusList(HTTP::Connection& connection, HTML::Instance& instance
             {
                 HTML::TableBody tableBody(instance);
 
-                unsigned long numberOfServuses = Database::Servuses::TotalNumber();
-                for (unsigned int servusIndex = 0;
-                     servusIndex < numberOfServuses;
-                     servusIndex++)
-                {
-                    Database::Servus& servus =
-                            Database::Servuses::ServusByIndex(servusIndex);
+                Database::ServusPresence& presence = Database::ServusPresence::SharedInstance();
 
+                Database::EntityList<Database::Servus> servuses = Database::Servuses::AllServuses();
+
+                for (Database::Servus& servus : servuses)
+                {
                     HTML::TableRow tableRow(instance);
 
                     {
@@ -361,7 +445,9 @@ WWW::Site::pageServusList(HTTP::Connection& connection, HTML::Instance& instance
                         tableDataCell.plain("Disabled");
                     }
 
-                    if (servus.online == true)
+                    Database::ServusPresenceRecord record;
+
+                    if (presence.online(servus.servusId, record) == true)
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "green");
 
@@ -377,7 +463,7 @@ WWW::Site::pageServusList(HTTP::Connection& connection, HTML::Instance& instance
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "dump");
 
-                        tableDataCell.plain(servus.authenticator);
+                        tableDataCell.plain(servus.authenticator.asString());
                     }
 
                     {
@@ -470,8 +556,6 @@ WWW::Site::pageServusList(HTTP::Connection& connection, HTML::Instance& instance
                             url.plain("[Aktivieren]");
                         } // HTML.URL
                     }
-
-                    delete &servus;
                 }
             }
         }
@@ -516,11 +600,9 @@ WWW::Site::pageServusEditForm(HTTP::Connection& connection, HTML::Instance& inst
 
     if (servusId != 0)
     {
-        Database::Servus& servus = Database::Servuses::ServusById(servusId);
+        Database::Servus servus = Database::Servuses::ServusById(servusId);
 
         servusTitle = servus.title;
-
-        delete &servus;
     }
 
     {
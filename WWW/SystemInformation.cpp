@@ -9,7 +9,13 @@
 //
 #include "Primus/Configuration.hpp"
 #include "Primus/Kernel.hpp"
+#include "Primus/ReceiveBuffers.hpp"
 #include "Primus/Anticipator/Service.hpp"
+#include "Primus/Database/Debug.hpp"
+#include "Primus/Dispatcher/Backpressure.hpp"
+#include "Primus/Dispatcher/Retransmissions.hpp"
+#include "Primus/Dispatcher/Service.hpp"
+#include "Primus/Dispatcher/Spool.hpp"
 #include "Primus/WWW/Home.hpp"
 
 /**
@@ -262,6 +268,483 @@ WWW::Site::pageSystemInformation(HTTP::Connection& connection, HTML::Instance& i
                 }
             }
         }
+
+        {
+            Primus::ReceiveBufferPool& receiveBuffers = Primus::ReceiveBufferPool::SharedInstance();
+
+            HTML::Table table(instance);
+
+            {
+                HTML::Caption caption(instance);
+
+                caption.plain("Empfangspuffer");
+            }
+
+            {
+                HTML::TableBody tableBody(instance);
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Klein (4 KiB):");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        const Primus::ReceiveBufferStatistics statistics =
+                                receiveBuffers.statistics(Primus::SmallReceiveBuffer);
+
+                        tableDataCell.plain("%lu in Benutzung (max. %lu), %lu frei, %lu Anforderungen, %lu Allokationen",
+                                statistics.inUse,
+                                statistics.peakInUse,
+                                statistics.idle,
+                                statistics.acquisitions,
+                                statistics.allocations);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Groß (64 KiB):");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        const Primus::ReceiveBufferStatistics statistics =
+                                receiveBuffers.statistics(Primus::LargeReceiveBuffer);
+
+                        tableDataCell.plain("%lu in Benutzung (max. %lu), %lu frei, %lu Anforderungen, %lu Allokationen",
+                                statistics.inUse,
+                                statistics.peakInUse,
+                                statistics.idle,
+                                statistics.acquisitions,
+                                statistics.allocations);
+                    }
+                }
+            }
+        }
+
+        {
+            Primus::Debug& debug = Primus::Debug::SharedInstance();
+
+            const Primus::DebugStatistics statistics = debug.statistics();
+
+            HTML::Table table(instance);
+
+            {
+                HTML::Caption caption(instance);
+
+                caption.plain("Debug-Protokoll");
+            }
+
+            {
+                HTML::TableBody tableBody(instance);
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Geschrieben:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.written);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Verworfen:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.dropped);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("In Warteschlange:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.queued);
+                    }
+                }
+            }
+        }
+
+        {
+            Dispatcher::Service& dispatcher = Dispatcher::Service::SharedInstance();
+
+            const Dispatcher::TimerStatistics statistics = dispatcher.timerStatistics();
+
+            HTML::Table table(instance);
+
+            {
+                HTML::Caption caption(instance);
+
+                caption.plain("Servus-Sitzungstimer");
+            }
+
+            {
+                HTML::TableBody tableBody(instance);
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Aktiv:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.armed);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Abgelaufen vor erstem Datagramm:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.expirations[Dispatcher::FirstDatagramTimeout]);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Abgelaufen bei unvollständigem Datagramm:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.expirations[Dispatcher::DatagramCompletionTimeout]);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Abgelaufen ohne Neutrino:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.expirations[Dispatcher::KeepAliveTimeout]);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Abgelaufen beim Senden:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.expirations[Dispatcher::TransmissionTimeout]);
+                    }
+                }
+            }
+        }
+
+        {
+            Dispatcher::Spool& spool = Dispatcher::Spool::SharedInstance();
+
+            if (spool.enabled() == true)
+            {
+                const Dispatcher::SpoolStatistics statistics = spool.statistics();
+
+                HTML::Table table(instance);
+
+                {
+                    HTML::Caption caption(instance);
+
+                    caption.plain("Zwischenspeicher");
+                }
+
+                {
+                    HTML::TableBody tableBody(instance);
+
+                    {
+                        HTML::TableRow tableRow(instance);
+
+                        {
+                            HTML::TableHeadCell tableHeadCell(instance);
+
+                            tableHeadCell.plain("Gespeichert:");
+                        }
+
+                        {
+                            HTML::TableDataCell tableDataCell(instance);
+
+                            tableDataCell.plain("%lu", statistics.appended);
+                        }
+                    }
+
+                    {
+                        HTML::TableRow tableRow(instance);
+
+                        {
+                            HTML::TableHeadCell tableHeadCell(instance);
+
+                            tableHeadCell.plain("Nachgetragen:");
+                        }
+
+                        {
+                            HTML::TableDataCell tableDataCell(instance);
+
+                            tableDataCell.plain("%lu", statistics.replayed);
+                        }
+                    }
+
+                    {
+                        HTML::TableRow tableRow(instance);
+
+                        {
+                            HTML::TableHeadCell tableHeadCell(instance);
+
+                            tableHeadCell.plain("Abgelehnt:");
+                        }
+
+                        {
+                            HTML::TableDataCell tableDataCell(instance);
+
+                            tableDataCell.plain("%lu", statistics.rejected);
+                        }
+                    }
+
+                    {
+                        HTML::TableRow tableRow(instance);
+
+                        {
+                            HTML::TableHeadCell tableHeadCell(instance);
+
+                            tableHeadCell.plain("Übersprungen (Bytes):");
+                        }
+
+                        {
+                            HTML::TableDataCell tableDataCell(instance);
+
+                            tableDataCell.plain("%lu", statistics.skipped);
+                        }
+                    }
+
+                    {
+                        HTML::TableRow tableRow(instance);
+
+                        {
+                            HTML::TableHeadCell tableHeadCell(instance);
+
+                            tableHeadCell.plain("Ausstehend (Bytes):");
+                        }
+
+                        {
+                            HTML::TableDataCell tableDataCell(instance);
+
+                            tableDataCell.plain("%lu", statistics.backlog);
+                        }
+                    }
+                }
+            }
+        }
+
+        {
+            Dispatcher::Retransmissions& retransmissions = Dispatcher::Retransmissions::SharedInstance();
+
+            const Dispatcher::RetransmissionStatistics statistics = retransmissions.statistics();
+
+            HTML::Table table(instance);
+
+            {
+                HTML::Caption caption(instance);
+
+                caption.plain("Wiederholte Übertragungen");
+            }
+
+            {
+                HTML::TableBody tableBody(instance);
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Gemerkte Übertragungen:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.remembered);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Abgefangene Wiederholungen:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.absorbed);
+                    }
+                }
+            }
+        }
+
+        {
+            Dispatcher::Backpressure& backpressure = Dispatcher::Backpressure::SharedInstance();
+
+            const Dispatcher::BackpressureStatistics statistics = backpressure.statistics();
+
+            HTML::Table table(instance);
+
+            {
+                HTML::Caption caption(instance);
+
+                caption.plain("Lastregelung");
+            }
+
+            {
+                HTML::TableBody tableBody(instance);
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Gedrosselt:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%s", (statistics.throttled == true) ? "ja" : "nein");
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Wartende Messwerte:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.queuedReadings);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Latenz (ms):");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.depositLatency);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Zwischenspeicher-Rückstand (Bytes):");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.spoolBacklog);
+                    }
+                }
+
+                {
+                    HTML::TableRow tableRow(instance);
+
+                    {
+                        HTML::TableHeadCell tableHeadCell(instance);
+
+                        tableHeadCell.plain("Drosselungen:");
+                    }
+
+                    {
+                        HTML::TableDataCell tableDataCell(instance);
+
+                        tableDataCell.plain("%lu", statistics.numberOfThrottlings);
+                    }
+                }
+            }
+        }
     }
 }
 #pragma GCC diagnostic pop
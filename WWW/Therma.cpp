@@ -2,6 +2,7 @@
 //
 #include <cstdbool>
 #include <string>
+#include <unordered_map>
 
 // Common definition files.
 //
@@ -15,6 +16,7 @@
 #include "Primus/Database/DHTSensor.hpp"
 #include "Primus/Database/DHTSensorList.hpp"
 #include "Primus/Database/Servus.hpp"
+#include "Primus/Database/ServusConfigurations.hpp"
 #include "Primus/Database/Servuses.hpp"
 #include "Primus/Database/Therma.hpp"
 #include "Primus/Database/Thermas.hpp"
@@ -53,11 +55,14 @@ WWW::Site::pageTherma(HTTP::Connection& connection, HTML::Instance& instance)
                         if (thermaTitle.empty() == true)
                             throw HTTP::ArgumentDoesNotExist();
 
-                        Database::Therma& therma = Database::Thermas::SensorById(thermaId);
+                        Database::Therma therma = Database::Thermas::SensorById(thermaId);
 
                         therma.setTitle(thermaTitle);
 
-                        delete &therma;
+                        Database::ServusConfigurations& servusConfigurations =
+                                Database::ServusConfigurations::SharedInstance();
+
+                        servusConfigurations.invalidate();
                     }
                     catch (HTTP::ArgumentDoesNotExist&)
                     {
@@ -87,10 +92,19 @@ WWW::Site::pageTherma(HTTP::Connection& connection, HTML::Instance& instance)
 void
 WWW::Site::pageThermaDatasheet(HTTP::Connection& connection, HTML::Instance& instance)
 {
-    unsigned long numberOfDHTSensors = Database::DHTSensorList::TotalNumber();
-    unsigned long numberOfDSSensors = Database::Thermas::TotalNumber();
+    Database::EntityList<Database::DHTSensor> dhtSensors = Database::DHTSensorList::AllSensors();
+    Database::EntityList<Database::Therma> dsSensors = Database::Thermas::AllSensors();
+
+    // Titles of servuses are looked up in a single query, not once per sensor.
+    //
+    std::unordered_map<unsigned long, std::string> servusTitles;
+
+    for (Database::Servus& servus : Database::Servuses::AllServuses())
+    {
+        servusTitles[servus.servusId] = servus.title;
+    }
 
-    if ((numberOfDHTSensors > 0) && (numberOfDSSensors > 0))
+    if ((dhtSensors.empty() == false) && (dsSensors.empty() == false))
     { // HTML.Division
         HTML::Division division(instance, "full", "slice");
 
@@ -169,12 +183,8 @@ WWW::Site::pageThermaDatasheet(HTTP::Connection& connection, HTML::Instance& ins
             {
                 HTML::TableBody tableBody(instance);
 
-                for (unsigned int sensorIndex = 0;
-                     sensorIndex < numberOfDHTSensors;
-                     sensorIndex++)
+                for (Database::DHTSensor& sensor : dhtSensors)
                 {
-                    Database::DHTSensor& sensor = Database::DHTSensorList::SensorByIndex(sensorIndex);
-
                     HTML::TableRow tableRow(instance);
 
                     {
@@ -186,11 +196,7 @@ WWW::Site::pageThermaDatasheet(HTTP::Connection& connection, HTML::Instance& ins
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "centered");
 
-                        Database::Servus& servus = Database::Servuses::ServusById(sensor.servusId);
-
-                        tableDataCell.plain(servus.title);
-
-                        delete &servus;
+                        tableDataCell.plain(servusTitles[sensor.servusId]);
                     }
 
                     float lastKnownHumidity = sensor.lastKnownHumidity();
@@ -248,16 +254,10 @@ WWW::Site::pageThermaDatasheet(HTTP::Connection& connection, HTML::Instance& ins
                                 sensor.temperatureEdge,
                                 sensor.humidityEdge);
                     }
-
-                    delete &sensor;
                 }
 
-                for (unsigned int sensorIndex = 0;
-                     sensorIndex < numberOfDSSensors;
-                     sensorIndex++)
+                for (Database::Therma& sensor : dsSensors)
                 {
-                    Database::Therma& sensor = Database::Thermas::SensorByIndex(sensorIndex);
-
                     HTML::TableRow tableRow(instance);
 
                     {
@@ -269,11 +269,7 @@ WWW::Site::pageThermaDatasheet(HTTP::Connection& connection, HTML::Instance& ins
                     {
                         HTML::TableDataCell tableDataCell(instance, HTML::Nothing, "centered");
 
-                        Database::Servus& servus = Database::Servuses::ServusById(sensor.servusId);
-
-                        tableDataCell.plain(servus.title);
-
-                        delete &servus;
+                        tableDataCell.plain(servusTitles[sensor.servusId]);
                     }
 
                     float lastKnownTemperature = sensor.lastKnownTemperature();
@@ -369,8 +365,6 @@ WWW::Site::pageThermaDatasheet(HTTP::Connection& connection, HTML::Instance& ins
                             url.plain("[Diagramm]");
                         } // HTML.URL
                     }
-
-                    delete &sensor;
                 }
             }
         }
@@ -412,12 +406,10 @@ WWW::Site::pageThermaDiagram(HTTP::Connection& connection, HTML::Instance& insta
                 {
                     HTML::Script script(instance, "text/javascript", HTML::Nothing);
 
-                    Database::Therma& therma = Database::Thermas::SensorById(thermaId);
+                    Database::Therma therma = Database::Thermas::SensorById(thermaId);
 
                     script.plain(therma.diagramAsJava());
                     script.plain("new LineChart(document.getElementById('Diagram'), data);");
-
-                    delete &therma;
                 }
             }
         }
@@ -465,11 +457,9 @@ WWW::Site::pageThermaEditForm(HTTP::Connection& connection, HTML::Instance& inst
 
     if (thermaId != 0)
     {
-        Database::Therma& therma = Database::Thermas::SensorById(thermaId);
+        Database::Therma therma = Database::Thermas::SensorById(thermaId);
 
         thermaTitle = therma.title;
-
-        delete &therma;
     }
 
     {